@@ -0,0 +1,2182 @@
+/* generated by gen-opcodes.py, one kernel per cb-prefixed opcode */
+
+void
+cb_rlc_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rlc_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v >> 7;
+    v = (v << 1) | c;
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rrc_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v & 1;
+    v = (v >> 1) | (c << 7);
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rl_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v >> 7;
+    v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_rr_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v & 1;
+    v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v >> 7;
+    v = v << 1;
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sla_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v >> 7;
+    v = v << 1;
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_sra_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v & 1;
+    v = (v >> 1) | (v & 0x80);
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_swap_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = 0;
+    v = (v << 4) | (v >> 4);
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_b(void)
+{
+    u8 v = reg.br.b;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.b = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_c(void)
+{
+    u8 v = reg.br.c;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.c = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_d(void)
+{
+    u8 v = reg.br.d;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.d = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_e(void)
+{
+    u8 v = reg.br.e;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.e = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_h(void)
+{
+    u8 v = reg.br.h;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.h = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_l(void)
+{
+    u8 v = reg.br.l;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.l = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl);
+    u8 c = v & 1;
+    v = v >> 1;
+    poke8(reg.wr.hl, v);
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_srl_a(void)
+{
+    u8 v = reg.br.a;
+    u8 c = v & 1;
+    v = v >> 1;
+    reg.br.a = v;
+    reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);
+}
+
+void
+cb_bit_0_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_0_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x01) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_1_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x02) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_2_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x04) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_3_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x08) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_4_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x10) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_5_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x20) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_6_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x40) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_b(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.b & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_c(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.c & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_d(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.d & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_e(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.e & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_h(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.h & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_l(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.l & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_deref_hl(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((peek8(reg.wr.hl) & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_bit_7_a(void)
+{
+    reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | ((reg.br.a & 0x80) ? 0 : flag_mask_z);
+}
+
+void
+cb_res_0_b(void)
+{
+    u8 v = reg.br.b & 0xfe;
+    reg.br.b = v;
+}
+
+void
+cb_res_0_c(void)
+{
+    u8 v = reg.br.c & 0xfe;
+    reg.br.c = v;
+}
+
+void
+cb_res_0_d(void)
+{
+    u8 v = reg.br.d & 0xfe;
+    reg.br.d = v;
+}
+
+void
+cb_res_0_e(void)
+{
+    u8 v = reg.br.e & 0xfe;
+    reg.br.e = v;
+}
+
+void
+cb_res_0_h(void)
+{
+    u8 v = reg.br.h & 0xfe;
+    reg.br.h = v;
+}
+
+void
+cb_res_0_l(void)
+{
+    u8 v = reg.br.l & 0xfe;
+    reg.br.l = v;
+}
+
+void
+cb_res_0_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xfe;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_0_a(void)
+{
+    u8 v = reg.br.a & 0xfe;
+    reg.br.a = v;
+}
+
+void
+cb_res_1_b(void)
+{
+    u8 v = reg.br.b & 0xfd;
+    reg.br.b = v;
+}
+
+void
+cb_res_1_c(void)
+{
+    u8 v = reg.br.c & 0xfd;
+    reg.br.c = v;
+}
+
+void
+cb_res_1_d(void)
+{
+    u8 v = reg.br.d & 0xfd;
+    reg.br.d = v;
+}
+
+void
+cb_res_1_e(void)
+{
+    u8 v = reg.br.e & 0xfd;
+    reg.br.e = v;
+}
+
+void
+cb_res_1_h(void)
+{
+    u8 v = reg.br.h & 0xfd;
+    reg.br.h = v;
+}
+
+void
+cb_res_1_l(void)
+{
+    u8 v = reg.br.l & 0xfd;
+    reg.br.l = v;
+}
+
+void
+cb_res_1_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xfd;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_1_a(void)
+{
+    u8 v = reg.br.a & 0xfd;
+    reg.br.a = v;
+}
+
+void
+cb_res_2_b(void)
+{
+    u8 v = reg.br.b & 0xfb;
+    reg.br.b = v;
+}
+
+void
+cb_res_2_c(void)
+{
+    u8 v = reg.br.c & 0xfb;
+    reg.br.c = v;
+}
+
+void
+cb_res_2_d(void)
+{
+    u8 v = reg.br.d & 0xfb;
+    reg.br.d = v;
+}
+
+void
+cb_res_2_e(void)
+{
+    u8 v = reg.br.e & 0xfb;
+    reg.br.e = v;
+}
+
+void
+cb_res_2_h(void)
+{
+    u8 v = reg.br.h & 0xfb;
+    reg.br.h = v;
+}
+
+void
+cb_res_2_l(void)
+{
+    u8 v = reg.br.l & 0xfb;
+    reg.br.l = v;
+}
+
+void
+cb_res_2_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xfb;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_2_a(void)
+{
+    u8 v = reg.br.a & 0xfb;
+    reg.br.a = v;
+}
+
+void
+cb_res_3_b(void)
+{
+    u8 v = reg.br.b & 0xf7;
+    reg.br.b = v;
+}
+
+void
+cb_res_3_c(void)
+{
+    u8 v = reg.br.c & 0xf7;
+    reg.br.c = v;
+}
+
+void
+cb_res_3_d(void)
+{
+    u8 v = reg.br.d & 0xf7;
+    reg.br.d = v;
+}
+
+void
+cb_res_3_e(void)
+{
+    u8 v = reg.br.e & 0xf7;
+    reg.br.e = v;
+}
+
+void
+cb_res_3_h(void)
+{
+    u8 v = reg.br.h & 0xf7;
+    reg.br.h = v;
+}
+
+void
+cb_res_3_l(void)
+{
+    u8 v = reg.br.l & 0xf7;
+    reg.br.l = v;
+}
+
+void
+cb_res_3_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xf7;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_3_a(void)
+{
+    u8 v = reg.br.a & 0xf7;
+    reg.br.a = v;
+}
+
+void
+cb_res_4_b(void)
+{
+    u8 v = reg.br.b & 0xef;
+    reg.br.b = v;
+}
+
+void
+cb_res_4_c(void)
+{
+    u8 v = reg.br.c & 0xef;
+    reg.br.c = v;
+}
+
+void
+cb_res_4_d(void)
+{
+    u8 v = reg.br.d & 0xef;
+    reg.br.d = v;
+}
+
+void
+cb_res_4_e(void)
+{
+    u8 v = reg.br.e & 0xef;
+    reg.br.e = v;
+}
+
+void
+cb_res_4_h(void)
+{
+    u8 v = reg.br.h & 0xef;
+    reg.br.h = v;
+}
+
+void
+cb_res_4_l(void)
+{
+    u8 v = reg.br.l & 0xef;
+    reg.br.l = v;
+}
+
+void
+cb_res_4_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xef;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_4_a(void)
+{
+    u8 v = reg.br.a & 0xef;
+    reg.br.a = v;
+}
+
+void
+cb_res_5_b(void)
+{
+    u8 v = reg.br.b & 0xdf;
+    reg.br.b = v;
+}
+
+void
+cb_res_5_c(void)
+{
+    u8 v = reg.br.c & 0xdf;
+    reg.br.c = v;
+}
+
+void
+cb_res_5_d(void)
+{
+    u8 v = reg.br.d & 0xdf;
+    reg.br.d = v;
+}
+
+void
+cb_res_5_e(void)
+{
+    u8 v = reg.br.e & 0xdf;
+    reg.br.e = v;
+}
+
+void
+cb_res_5_h(void)
+{
+    u8 v = reg.br.h & 0xdf;
+    reg.br.h = v;
+}
+
+void
+cb_res_5_l(void)
+{
+    u8 v = reg.br.l & 0xdf;
+    reg.br.l = v;
+}
+
+void
+cb_res_5_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xdf;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_5_a(void)
+{
+    u8 v = reg.br.a & 0xdf;
+    reg.br.a = v;
+}
+
+void
+cb_res_6_b(void)
+{
+    u8 v = reg.br.b & 0xbf;
+    reg.br.b = v;
+}
+
+void
+cb_res_6_c(void)
+{
+    u8 v = reg.br.c & 0xbf;
+    reg.br.c = v;
+}
+
+void
+cb_res_6_d(void)
+{
+    u8 v = reg.br.d & 0xbf;
+    reg.br.d = v;
+}
+
+void
+cb_res_6_e(void)
+{
+    u8 v = reg.br.e & 0xbf;
+    reg.br.e = v;
+}
+
+void
+cb_res_6_h(void)
+{
+    u8 v = reg.br.h & 0xbf;
+    reg.br.h = v;
+}
+
+void
+cb_res_6_l(void)
+{
+    u8 v = reg.br.l & 0xbf;
+    reg.br.l = v;
+}
+
+void
+cb_res_6_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0xbf;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_6_a(void)
+{
+    u8 v = reg.br.a & 0xbf;
+    reg.br.a = v;
+}
+
+void
+cb_res_7_b(void)
+{
+    u8 v = reg.br.b & 0x7f;
+    reg.br.b = v;
+}
+
+void
+cb_res_7_c(void)
+{
+    u8 v = reg.br.c & 0x7f;
+    reg.br.c = v;
+}
+
+void
+cb_res_7_d(void)
+{
+    u8 v = reg.br.d & 0x7f;
+    reg.br.d = v;
+}
+
+void
+cb_res_7_e(void)
+{
+    u8 v = reg.br.e & 0x7f;
+    reg.br.e = v;
+}
+
+void
+cb_res_7_h(void)
+{
+    u8 v = reg.br.h & 0x7f;
+    reg.br.h = v;
+}
+
+void
+cb_res_7_l(void)
+{
+    u8 v = reg.br.l & 0x7f;
+    reg.br.l = v;
+}
+
+void
+cb_res_7_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) & 0x7f;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_res_7_a(void)
+{
+    u8 v = reg.br.a & 0x7f;
+    reg.br.a = v;
+}
+
+void
+cb_set_0_b(void)
+{
+    u8 v = reg.br.b | 0x01;
+    reg.br.b = v;
+}
+
+void
+cb_set_0_c(void)
+{
+    u8 v = reg.br.c | 0x01;
+    reg.br.c = v;
+}
+
+void
+cb_set_0_d(void)
+{
+    u8 v = reg.br.d | 0x01;
+    reg.br.d = v;
+}
+
+void
+cb_set_0_e(void)
+{
+    u8 v = reg.br.e | 0x01;
+    reg.br.e = v;
+}
+
+void
+cb_set_0_h(void)
+{
+    u8 v = reg.br.h | 0x01;
+    reg.br.h = v;
+}
+
+void
+cb_set_0_l(void)
+{
+    u8 v = reg.br.l | 0x01;
+    reg.br.l = v;
+}
+
+void
+cb_set_0_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x01;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_0_a(void)
+{
+    u8 v = reg.br.a | 0x01;
+    reg.br.a = v;
+}
+
+void
+cb_set_1_b(void)
+{
+    u8 v = reg.br.b | 0x02;
+    reg.br.b = v;
+}
+
+void
+cb_set_1_c(void)
+{
+    u8 v = reg.br.c | 0x02;
+    reg.br.c = v;
+}
+
+void
+cb_set_1_d(void)
+{
+    u8 v = reg.br.d | 0x02;
+    reg.br.d = v;
+}
+
+void
+cb_set_1_e(void)
+{
+    u8 v = reg.br.e | 0x02;
+    reg.br.e = v;
+}
+
+void
+cb_set_1_h(void)
+{
+    u8 v = reg.br.h | 0x02;
+    reg.br.h = v;
+}
+
+void
+cb_set_1_l(void)
+{
+    u8 v = reg.br.l | 0x02;
+    reg.br.l = v;
+}
+
+void
+cb_set_1_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x02;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_1_a(void)
+{
+    u8 v = reg.br.a | 0x02;
+    reg.br.a = v;
+}
+
+void
+cb_set_2_b(void)
+{
+    u8 v = reg.br.b | 0x04;
+    reg.br.b = v;
+}
+
+void
+cb_set_2_c(void)
+{
+    u8 v = reg.br.c | 0x04;
+    reg.br.c = v;
+}
+
+void
+cb_set_2_d(void)
+{
+    u8 v = reg.br.d | 0x04;
+    reg.br.d = v;
+}
+
+void
+cb_set_2_e(void)
+{
+    u8 v = reg.br.e | 0x04;
+    reg.br.e = v;
+}
+
+void
+cb_set_2_h(void)
+{
+    u8 v = reg.br.h | 0x04;
+    reg.br.h = v;
+}
+
+void
+cb_set_2_l(void)
+{
+    u8 v = reg.br.l | 0x04;
+    reg.br.l = v;
+}
+
+void
+cb_set_2_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x04;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_2_a(void)
+{
+    u8 v = reg.br.a | 0x04;
+    reg.br.a = v;
+}
+
+void
+cb_set_3_b(void)
+{
+    u8 v = reg.br.b | 0x08;
+    reg.br.b = v;
+}
+
+void
+cb_set_3_c(void)
+{
+    u8 v = reg.br.c | 0x08;
+    reg.br.c = v;
+}
+
+void
+cb_set_3_d(void)
+{
+    u8 v = reg.br.d | 0x08;
+    reg.br.d = v;
+}
+
+void
+cb_set_3_e(void)
+{
+    u8 v = reg.br.e | 0x08;
+    reg.br.e = v;
+}
+
+void
+cb_set_3_h(void)
+{
+    u8 v = reg.br.h | 0x08;
+    reg.br.h = v;
+}
+
+void
+cb_set_3_l(void)
+{
+    u8 v = reg.br.l | 0x08;
+    reg.br.l = v;
+}
+
+void
+cb_set_3_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x08;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_3_a(void)
+{
+    u8 v = reg.br.a | 0x08;
+    reg.br.a = v;
+}
+
+void
+cb_set_4_b(void)
+{
+    u8 v = reg.br.b | 0x10;
+    reg.br.b = v;
+}
+
+void
+cb_set_4_c(void)
+{
+    u8 v = reg.br.c | 0x10;
+    reg.br.c = v;
+}
+
+void
+cb_set_4_d(void)
+{
+    u8 v = reg.br.d | 0x10;
+    reg.br.d = v;
+}
+
+void
+cb_set_4_e(void)
+{
+    u8 v = reg.br.e | 0x10;
+    reg.br.e = v;
+}
+
+void
+cb_set_4_h(void)
+{
+    u8 v = reg.br.h | 0x10;
+    reg.br.h = v;
+}
+
+void
+cb_set_4_l(void)
+{
+    u8 v = reg.br.l | 0x10;
+    reg.br.l = v;
+}
+
+void
+cb_set_4_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x10;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_4_a(void)
+{
+    u8 v = reg.br.a | 0x10;
+    reg.br.a = v;
+}
+
+void
+cb_set_5_b(void)
+{
+    u8 v = reg.br.b | 0x20;
+    reg.br.b = v;
+}
+
+void
+cb_set_5_c(void)
+{
+    u8 v = reg.br.c | 0x20;
+    reg.br.c = v;
+}
+
+void
+cb_set_5_d(void)
+{
+    u8 v = reg.br.d | 0x20;
+    reg.br.d = v;
+}
+
+void
+cb_set_5_e(void)
+{
+    u8 v = reg.br.e | 0x20;
+    reg.br.e = v;
+}
+
+void
+cb_set_5_h(void)
+{
+    u8 v = reg.br.h | 0x20;
+    reg.br.h = v;
+}
+
+void
+cb_set_5_l(void)
+{
+    u8 v = reg.br.l | 0x20;
+    reg.br.l = v;
+}
+
+void
+cb_set_5_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x20;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_5_a(void)
+{
+    u8 v = reg.br.a | 0x20;
+    reg.br.a = v;
+}
+
+void
+cb_set_6_b(void)
+{
+    u8 v = reg.br.b | 0x40;
+    reg.br.b = v;
+}
+
+void
+cb_set_6_c(void)
+{
+    u8 v = reg.br.c | 0x40;
+    reg.br.c = v;
+}
+
+void
+cb_set_6_d(void)
+{
+    u8 v = reg.br.d | 0x40;
+    reg.br.d = v;
+}
+
+void
+cb_set_6_e(void)
+{
+    u8 v = reg.br.e | 0x40;
+    reg.br.e = v;
+}
+
+void
+cb_set_6_h(void)
+{
+    u8 v = reg.br.h | 0x40;
+    reg.br.h = v;
+}
+
+void
+cb_set_6_l(void)
+{
+    u8 v = reg.br.l | 0x40;
+    reg.br.l = v;
+}
+
+void
+cb_set_6_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x40;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_6_a(void)
+{
+    u8 v = reg.br.a | 0x40;
+    reg.br.a = v;
+}
+
+void
+cb_set_7_b(void)
+{
+    u8 v = reg.br.b | 0x80;
+    reg.br.b = v;
+}
+
+void
+cb_set_7_c(void)
+{
+    u8 v = reg.br.c | 0x80;
+    reg.br.c = v;
+}
+
+void
+cb_set_7_d(void)
+{
+    u8 v = reg.br.d | 0x80;
+    reg.br.d = v;
+}
+
+void
+cb_set_7_e(void)
+{
+    u8 v = reg.br.e | 0x80;
+    reg.br.e = v;
+}
+
+void
+cb_set_7_h(void)
+{
+    u8 v = reg.br.h | 0x80;
+    reg.br.h = v;
+}
+
+void
+cb_set_7_l(void)
+{
+    u8 v = reg.br.l | 0x80;
+    reg.br.l = v;
+}
+
+void
+cb_set_7_deref_hl(void)
+{
+    u8 v = peek8(reg.wr.hl) | 0x80;
+    poke8(reg.wr.hl, v);
+}
+
+void
+cb_set_7_a(void)
+{
+    u8 v = reg.br.a | 0x80;
+    reg.br.a = v;
+}
+
+
+void (*cb_kernels[256])(void) = {
+    cb_rlc_b,
+    cb_rlc_c,
+    cb_rlc_d,
+    cb_rlc_e,
+    cb_rlc_h,
+    cb_rlc_l,
+    cb_rlc_deref_hl,
+    cb_rlc_a,
+    cb_rrc_b,
+    cb_rrc_c,
+    cb_rrc_d,
+    cb_rrc_e,
+    cb_rrc_h,
+    cb_rrc_l,
+    cb_rrc_deref_hl,
+    cb_rrc_a,
+    cb_rl_b,
+    cb_rl_c,
+    cb_rl_d,
+    cb_rl_e,
+    cb_rl_h,
+    cb_rl_l,
+    cb_rl_deref_hl,
+    cb_rl_a,
+    cb_rr_b,
+    cb_rr_c,
+    cb_rr_d,
+    cb_rr_e,
+    cb_rr_h,
+    cb_rr_l,
+    cb_rr_deref_hl,
+    cb_rr_a,
+    cb_sla_b,
+    cb_sla_c,
+    cb_sla_d,
+    cb_sla_e,
+    cb_sla_h,
+    cb_sla_l,
+    cb_sla_deref_hl,
+    cb_sla_a,
+    cb_sra_b,
+    cb_sra_c,
+    cb_sra_d,
+    cb_sra_e,
+    cb_sra_h,
+    cb_sra_l,
+    cb_sra_deref_hl,
+    cb_sra_a,
+    cb_swap_b,
+    cb_swap_c,
+    cb_swap_d,
+    cb_swap_e,
+    cb_swap_h,
+    cb_swap_l,
+    cb_swap_deref_hl,
+    cb_swap_a,
+    cb_srl_b,
+    cb_srl_c,
+    cb_srl_d,
+    cb_srl_e,
+    cb_srl_h,
+    cb_srl_l,
+    cb_srl_deref_hl,
+    cb_srl_a,
+    cb_bit_0_b,
+    cb_bit_0_c,
+    cb_bit_0_d,
+    cb_bit_0_e,
+    cb_bit_0_h,
+    cb_bit_0_l,
+    cb_bit_0_deref_hl,
+    cb_bit_0_a,
+    cb_bit_1_b,
+    cb_bit_1_c,
+    cb_bit_1_d,
+    cb_bit_1_e,
+    cb_bit_1_h,
+    cb_bit_1_l,
+    cb_bit_1_deref_hl,
+    cb_bit_1_a,
+    cb_bit_2_b,
+    cb_bit_2_c,
+    cb_bit_2_d,
+    cb_bit_2_e,
+    cb_bit_2_h,
+    cb_bit_2_l,
+    cb_bit_2_deref_hl,
+    cb_bit_2_a,
+    cb_bit_3_b,
+    cb_bit_3_c,
+    cb_bit_3_d,
+    cb_bit_3_e,
+    cb_bit_3_h,
+    cb_bit_3_l,
+    cb_bit_3_deref_hl,
+    cb_bit_3_a,
+    cb_bit_4_b,
+    cb_bit_4_c,
+    cb_bit_4_d,
+    cb_bit_4_e,
+    cb_bit_4_h,
+    cb_bit_4_l,
+    cb_bit_4_deref_hl,
+    cb_bit_4_a,
+    cb_bit_5_b,
+    cb_bit_5_c,
+    cb_bit_5_d,
+    cb_bit_5_e,
+    cb_bit_5_h,
+    cb_bit_5_l,
+    cb_bit_5_deref_hl,
+    cb_bit_5_a,
+    cb_bit_6_b,
+    cb_bit_6_c,
+    cb_bit_6_d,
+    cb_bit_6_e,
+    cb_bit_6_h,
+    cb_bit_6_l,
+    cb_bit_6_deref_hl,
+    cb_bit_6_a,
+    cb_bit_7_b,
+    cb_bit_7_c,
+    cb_bit_7_d,
+    cb_bit_7_e,
+    cb_bit_7_h,
+    cb_bit_7_l,
+    cb_bit_7_deref_hl,
+    cb_bit_7_a,
+    cb_res_0_b,
+    cb_res_0_c,
+    cb_res_0_d,
+    cb_res_0_e,
+    cb_res_0_h,
+    cb_res_0_l,
+    cb_res_0_deref_hl,
+    cb_res_0_a,
+    cb_res_1_b,
+    cb_res_1_c,
+    cb_res_1_d,
+    cb_res_1_e,
+    cb_res_1_h,
+    cb_res_1_l,
+    cb_res_1_deref_hl,
+    cb_res_1_a,
+    cb_res_2_b,
+    cb_res_2_c,
+    cb_res_2_d,
+    cb_res_2_e,
+    cb_res_2_h,
+    cb_res_2_l,
+    cb_res_2_deref_hl,
+    cb_res_2_a,
+    cb_res_3_b,
+    cb_res_3_c,
+    cb_res_3_d,
+    cb_res_3_e,
+    cb_res_3_h,
+    cb_res_3_l,
+    cb_res_3_deref_hl,
+    cb_res_3_a,
+    cb_res_4_b,
+    cb_res_4_c,
+    cb_res_4_d,
+    cb_res_4_e,
+    cb_res_4_h,
+    cb_res_4_l,
+    cb_res_4_deref_hl,
+    cb_res_4_a,
+    cb_res_5_b,
+    cb_res_5_c,
+    cb_res_5_d,
+    cb_res_5_e,
+    cb_res_5_h,
+    cb_res_5_l,
+    cb_res_5_deref_hl,
+    cb_res_5_a,
+    cb_res_6_b,
+    cb_res_6_c,
+    cb_res_6_d,
+    cb_res_6_e,
+    cb_res_6_h,
+    cb_res_6_l,
+    cb_res_6_deref_hl,
+    cb_res_6_a,
+    cb_res_7_b,
+    cb_res_7_c,
+    cb_res_7_d,
+    cb_res_7_e,
+    cb_res_7_h,
+    cb_res_7_l,
+    cb_res_7_deref_hl,
+    cb_res_7_a,
+    cb_set_0_b,
+    cb_set_0_c,
+    cb_set_0_d,
+    cb_set_0_e,
+    cb_set_0_h,
+    cb_set_0_l,
+    cb_set_0_deref_hl,
+    cb_set_0_a,
+    cb_set_1_b,
+    cb_set_1_c,
+    cb_set_1_d,
+    cb_set_1_e,
+    cb_set_1_h,
+    cb_set_1_l,
+    cb_set_1_deref_hl,
+    cb_set_1_a,
+    cb_set_2_b,
+    cb_set_2_c,
+    cb_set_2_d,
+    cb_set_2_e,
+    cb_set_2_h,
+    cb_set_2_l,
+    cb_set_2_deref_hl,
+    cb_set_2_a,
+    cb_set_3_b,
+    cb_set_3_c,
+    cb_set_3_d,
+    cb_set_3_e,
+    cb_set_3_h,
+    cb_set_3_l,
+    cb_set_3_deref_hl,
+    cb_set_3_a,
+    cb_set_4_b,
+    cb_set_4_c,
+    cb_set_4_d,
+    cb_set_4_e,
+    cb_set_4_h,
+    cb_set_4_l,
+    cb_set_4_deref_hl,
+    cb_set_4_a,
+    cb_set_5_b,
+    cb_set_5_c,
+    cb_set_5_d,
+    cb_set_5_e,
+    cb_set_5_h,
+    cb_set_5_l,
+    cb_set_5_deref_hl,
+    cb_set_5_a,
+    cb_set_6_b,
+    cb_set_6_c,
+    cb_set_6_d,
+    cb_set_6_e,
+    cb_set_6_h,
+    cb_set_6_l,
+    cb_set_6_deref_hl,
+    cb_set_6_a,
+    cb_set_7_b,
+    cb_set_7_c,
+    cb_set_7_d,
+    cb_set_7_e,
+    cb_set_7_h,
+    cb_set_7_l,
+    cb_set_7_deref_hl,
+    cb_set_7_a
+};
+
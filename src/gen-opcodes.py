@@ -59,6 +59,30 @@ def escape_keyword(head, kw, immediate=True):
     return "keyword_" + kw
 
 
+def flag_masks(flags):
+    masks = {'Z': 0x80, 'N': 0x40, 'H': 0x20, 'C': 0x10}
+    calc = 0
+    fixed = 0
+    for k, v in flags.items():
+        mask = masks[k.upper()]
+        if v == '-':
+            continue
+        elif v in '01':
+            fixed |= mask
+            if v == '1':
+                fixed |= mask >> 4
+        else:
+            calc |= mask
+    return calc, fixed
+
+
+def handler_name(op):
+    name = op.mnemonic.lower()
+    if name.startswith('illegal'):
+        name = 'illegal'
+    return name
+
+
 def make_keywords(op):
     keywords = []
     k1 = op.mnemonic.lower()
@@ -71,6 +95,90 @@ def make_keywords(op):
     return keywords
 
 
+def make_tables(opcodes, prefixed, handlers):
+    ops = []
+    infos = []
+
+    for k, v in opcodes.items():
+        i = any(arg.get('increment', False) for arg in v.operands)
+        d = any(arg.get('decrement', False) for arg in v.operands)
+        if i:
+            v.mnemonic += 'I'
+        if d:
+            v.mnemonic += 'D'
+        total_cycles = sum(v.cycles)
+        cycles    = '{' + ', '.join(str(c) for c in (v.cycles + [0])[:2]) + '}'
+        operands  = c_init(map(operand_to_c, v.operands))
+        flags     = '{' + ', '.join([f"'{f.lower()}'" for f in v.flags.values()]) + '}'
+        keywords = make_keywords(v)
+        keywords_string = "{" + ', '.join(keywords) + "}"
+        num_keywords = len(v.operands) + 1
+        op = f"{{0x{k:02x}, \"{v.mnemonic.lower()}\", {v.bytes}, {total_cycles}, {cycles}, {len(v.operands)}, {operands}, {str(v.immediate).lower()}, {flags}, {str(prefixed).lower()}, {num_keywords}, {keywords_string}}}"
+        ops.append(op)
+
+        handler = handler_name(v)
+        if handler not in handlers:
+            handlers.append(handler)
+        cycles_alt = v.cycles[1] if len(v.cycles) > 1 else v.cycles[0]
+        flags_calc, flags_fixed = (0, 0) if prefixed else flag_masks(v.flags)
+        info = f"{{handler_{handler}, {v.bytes}, {v.cycles[0]}, {cycles_alt}, 0x{flags_calc:02x}, 0x{flags_fixed:02x}, {keywords[1]}, {keywords[2]}}}"
+        infos.append(info)
+
+    return ops, infos
+
+
+def cb_kernel(code, op):
+    """
+    Specialised C function for one cb-prefixed opcode, the register and bit
+    index are baked in so nothing is decoded at run time.
+    """
+    family = op.mnemonic.lower()
+    target = op.operands[-1]['name'].lower()
+    if op.operands[-1]['immediate']:
+        name = f"cb_{family}_{target}"
+        load = f"reg.br.{target}"
+        store = f"reg.br.{target} = v;"
+    else:
+        name = f"cb_{family}_deref_{target}"
+        load = f"peek8(reg.wr.{target})"
+        store = f"poke8(reg.wr.{target}, v);"
+
+    if family == 'bit':
+        n = int(op.operands[0]['name'])
+        name = f"cb_bit_{n}_{name[7:]}"
+        body = [
+            f"reg.br.f = (reg.br.f & flag_mask_cy) | flag_mask_h | (({load} & 0x{1 << n:02x}) ? 0 : flag_mask_z);",
+            ]
+    elif family in ['res', 'set']:
+        n = int(op.operands[0]['name'])
+        name = f"cb_{family}_{n}_{name[7:]}"
+        expr = f"{load} & 0x{~(1 << n) & 0xff:02x}" if family == 'res' else f"{load} | 0x{1 << n:02x}"
+        body = [
+            f"u8 v = {expr};",
+            store,
+            ]
+    else:
+        shift = {
+                'rlc':  ["u8 c = v >> 7;", "v = (v << 1) | c;"],
+                'rrc':  ["u8 c = v & 1;",  "v = (v >> 1) | (c << 7);"],
+                'rl':   ["u8 c = v >> 7;", "v = (v << 1) | (flag_cy(reg.br.f) ? 0x01 : 0);"],
+                'rr':   ["u8 c = v & 1;",  "v = (v >> 1) | (flag_cy(reg.br.f) ? 0x80 : 0);"],
+                'sla':  ["u8 c = v >> 7;", "v = v << 1;"],
+                'sra':  ["u8 c = v & 1;",  "v = (v >> 1) | (v & 0x80);"],
+                'swap': ["u8 c = 0;",      "v = (v << 4) | (v >> 4);"],
+                'srl':  ["u8 c = v & 1;",  "v = v >> 1;"],
+                }[family]
+        body = [
+            f"u8 v = {load};",
+            *shift,
+            store,
+            "reg.br.f = (v ? 0 : flag_mask_z) | (c ? flag_mask_cy : 0);",
+            ]
+
+    lines = ["void", f"{name}(void)", "{"] + ["    " + l for l in body] + ["}"]
+    return name, '\n'.join(lines)
+
+
 def main():
     with open("./src/gb-opcodes/Opcodes.json") as f:
         json_opcodes = json.load(f)
@@ -111,32 +219,62 @@ def main():
             Keyword words[4];
         } Opcode;
 
+        /* hot per-opcode data read by eval(), 8 bytes per entry */
+        typedef struct Opcode_Info {
+            u8 handler;
+            u8 bytes;
+            u8 cycles;
+            u8 cycles_alt;  /* branch not taken */
+            u8 flags_calc;  /* flag_mask_* bits computed from the result */
+            u8 flags_fixed; /* high nibble: flags forced, low nibble: their values */
+            u8 dst;
+            u8 src;
+        } Opcode_Info;
+
         """).strip())
 
-        f.write("\n\nOpcode opcode_table[256] = {\n")
-
-        ops = []
-
-        for k, v in unprefixed.items():
-            i = any(arg.get('increment', False) for arg in v.operands)
-            d = any(arg.get('decrement', False) for arg in v.operands)
-            if i:
-                v.mnemonic += 'I'
-            if d:
-                v.mnemonic += 'D'
-            total_cycles = sum(v.cycles)
-            cycles    = '{' + ', '.join(str(c) for c in (v.cycles + [0])[:2]) + '}'
-            operands  = c_init(map(operand_to_c, v.operands))
-            flags     = '{' + ', '.join([f"'{f.lower()}'" for f in v.flags.values()]) + '}'
-            keywords = make_keywords(v)
-            keywords_string = "{" + ', '.join(keywords) + "}"
-            num_keywords = len(v.operands) + 1
-            op = f"{{0x{k:02x}, \"{v.mnemonic.lower()}\", {v.bytes}, {total_cycles}, {cycles}, {len(v.operands)}, {operands}, {str(v.immediate).lower()}, {flags}, false, {num_keywords}, {keywords_string}}}"
-            ops.append(op)
+        handlers = []
+        ops, infos = make_tables(unprefixed, False, handlers)
+        cb_ops, cb_infos = make_tables(cbprefixed, True, handlers)
+
+        f.write("\n\n#define LIST_OF_HANDLERS \\\n")
+        f.write(''.join(f"    X({h}) \\\n" for h in handlers))
+        f.write("    X(end)\n")
+        f.write(dedent("""
+
+        typedef enum Handler {
+        #define X(name) handler_##name,
+            LIST_OF_HANDLERS
+        #undef X
+        } Handler;
+        """))
+
+        f.write("\nOpcode_Info opcode_info[256] = {\n")
+        f.write('    ' + ',\n    '.join(infos))
+        f.write("\n};\n\n")
 
+        f.write("/* cb kernels set their own flags, so flags_calc/fixed are left clear */\n")
+        f.write("Opcode_Info cb_opcode_info[256] = {\n")
+        f.write('    ' + ',\n    '.join(cb_infos))
+        f.write("\n};\n\n")
+
+        f.write("/* cold data, only used by the assembler and the printers */\n")
+        f.write("Opcode opcode_table[256] = {\n")
         f.write('    ' + ',\n    '.join(ops))
         f.write("\n};\n\n")
 
+        f.write("Opcode cb_opcode_table[256] = {\n")
+        f.write('    ' + ',\n    '.join(cb_ops))
+        f.write("\n};\n\n")
+
+    with open(sys.argv[2], 'w') as f:
+        kernels = [cb_kernel(k, v) for (k, v) in cbprefixed.items()]
+        f.write("/* generated by gen-opcodes.py, one kernel per cb-prefixed opcode */\n\n")
+        f.write('\n\n'.join(body for (name, body) in kernels))
+        f.write("\n\n\nvoid (*cb_kernels[256])(void) = {\n")
+        f.write('    ' + ',\n    '.join(name for (name, body) in kernels))
+        f.write("\n};\n\n")
+
     return
 
 
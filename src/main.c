@@ -2,7 +2,36 @@
 #include <ctype.h>
 #include <assert.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <math.h>
+#include <signal.h>
+
+#include <stdatomic.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HAVE_TSC 1
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
 
 #define true  1
 #define false 0
@@ -80,6 +109,14 @@ char *type_names[] = {
     X(28h) \
     X(30h) \
     X(38h) \
+    X(0) \
+    X(1) \
+    X(2) \
+    X(3) \
+    X(4) \
+    X(5) \
+    X(6) \
+    X(7) \
     X(a) \
     X(a16) \
     X(a8) \
@@ -89,6 +126,7 @@ char *type_names[] = {
     X(and) \
     X(b) \
     X(bc) \
+    X(bit) \
     X(c) \
     X(call) \
     X(ccf) \
@@ -119,17 +157,27 @@ char *type_names[] = {
     X(push) \
     X(r8) \
     X(ret) \
+    X(res) \
     X(reti) \
+    X(rl) \
     X(rla) \
+    X(rlc) \
     X(rlca) \
+    X(rr) \
     X(rra) \
+    X(rrc) \
     X(rrca) \
     X(rst) \
     X(sbc) \
     X(scf) \
+    X(set) \
+    X(sla) \
+    X(sra) \
+    X(srl) \
     X(sp) \
     X(stop) \
     X(sub) \
+    X(swap) \
     X(u8) \
     X(u16) \
     X(xor) \
@@ -263,24 +311,756 @@ typedef struct Dict {
 
 struct CPU {
     int ei;
+    int halted;
+    u64 cycles;
+    u64 writes;
+    u64 polls;        /* reads of registers that change by themselves */
 } cpu;
 
+
+#define CYCLES_PER_LINE 456
+#define LINES_PER_FRAME 154
+
+#define int_mask_vblank (1 << 0)
+#define int_mask_stat   (1 << 1)
+#define int_mask_timer  (1 << 2)
+#define int_mask_serial (1 << 3)
+#define int_mask_joypad (1 << 4)
+
+#define LIST_OF_EVENTS \
+    X(ppu) \
+    X(timer) \
+    X(debug) \
+    X(serial) \
+    X(link) \
+    X(end)
+
+typedef enum Event {
+#define X(name) event_##name,
+    LIST_OF_EVENTS
+#undef X
+} Event;
+
+/* hardware state only changes at these cycle counts */
+struct scheduler {
+    u64 at[event_end];
+    u64 next;
+} sched;
+
+/* last backwards branch target, to spot loops that can't make progress */
+struct idle {
+    u16 pc;
+    u64 cycles;
+    u64 writes;
+    u64 polls;
+    int ei;
+    union registers reg;
+} idle;
+
 union registers reg;
 union registers prev_reg;
 
 u8 memory[0x10000];
 
+u8 *rom;
+u32 rom_size;
+
+
+#define page_read_hook   (1 << 0)
+#define page_write_hook  (1 << 1)
+#define page_break       (1 << 2)
+#define page_read_watch  (1 << 3)
+#define page_write_watch (1 << 4)
+#define page_read_count  (1 << 5)
+#define page_write_count (1 << 6)
+
+#define page_read_slow  (page_read_hook | page_read_watch | page_read_count)
+#define page_write_slow (page_write_hook | page_write_watch | page_write_count)
+
+/* 256 byte pages, pages without hook bits are a plain load/store */
+struct memory_map {
+    u8 *page[0x100];
+    u8 attr[0x100];
+    u8 dirty[0x100];          /* written since the last state hash */
+    u32 rom_offset[0x80];     /* where in the rom each page below $8000 is from */
+} map;
+
+struct cart {
+    int mbc;
+    int rom_bank;
+    int num_rom_banks;
+    u8 *ram;            /* malloc'd, or the mmap'd .sav */
+    u32 ram_size;
+    int ram_bank;
+    int ram_on;
+    int bank2;          /* mbc1 $4000 register and banking mode */
+    int mode;
+    int battery;
+    int sav_shared;     /* writes go to the .sav, msync'd on disable and exit */
+} cart;
+
+/* what reads of cart ram see while it is disabled */
+u8 cart_off[0x100];
+
+#define MAX_CHEATS 64
+
+/* game genie, compare is -1 when the code has none */
+typedef struct Patch {
+    u16 addr;
+    u8 value;
+    i16 compare;
+} Patch;
+
+/* gameshark */
+typedef struct Freeze {
+    u16 addr;
+    u8 value;
+} Freeze;
+
+/*
+ * Patched rom pages get a shadow copy that the map points at instead of
+ * the rom, so reads stay a plain load. Freezes are written once a frame.
+ */
+struct cheats {
+    Patch patches[MAX_CHEATS];
+    int num_patches;
+    Freeze freezes[MAX_CHEATS];
+    int num_freezes;
+    u8 **shadow;        /* per 256 byte rom page, NULL until a patch */
+} cheats;
+
+
+#define io_joyp 0xff00
+#define io_sb   0xff01
+#define io_sc   0xff02
+#define io_div  0xff04
+#define io_tima 0xff05
+#define io_tma  0xff06
+#define io_tac  0xff07
+#define io_dma  0xff46
+#define io_nr52 0xff26
+#define io_lcdc 0xff40
+#define io_stat 0xff41
+#define io_scy  0xff42
+#define io_scx  0xff43
+#define io_ly   0xff44
+#define io_lyc  0xff45
+#define io_bgp  0xff47
+#define io_obp0 0xff48
+#define io_obp1 0xff49
+#define io_wy   0xff4a
+#define io_wx   0xff4b
+#define io_if   0xff0f
+#define io_ie   0xffff
+
+#define lcdc_bg         (1 << 0)
+#define lcdc_obj        (1 << 1)
+#define lcdc_obj_size   (1 << 2)
+#define lcdc_bg_map     (1 << 3)
+#define lcdc_tile_data  (1 << 4)
+#define lcdc_window     (1 << 5)
+#define lcdc_window_map (1 << 6)
+#define lcdc_on         (1 << 7)
+
+#define stat_lyc_equal  (1 << 2)
+#define stat_int_hblank (1 << 3)
+#define stat_int_vblank (1 << 4)
+#define stat_int_oam    (1 << 5)
+#define stat_int_lyc    (1 << 6)
+
+#define SCREEN_W 160
+#define SCREEN_H 144
+
+#define NUM_TILES 384
+
+/* tiles decoded to colour indices, redone lazily after a vram write */
+struct tile_cache {
+    u8 px[NUM_TILES][8][8];
+    u8 flipped[NUM_TILES][8][8];
+    u8 dirty[NUM_TILES];
+} tiles;
+
+/*
+ * div and tima are worked out from the cycle count when they are read,
+ * the only thing scheduled is the next tima overflow.
+ */
+struct timer {
+    u64 div_base;     /* cycle the internal counter was last reset */
+    u64 base;         /* cycle tima was last brought up to date */
+    int tima;
+} timer;
+
+#define joy_right  (1 << 0)
+#define joy_left   (1 << 1)
+#define joy_up     (1 << 2)
+#define joy_down   (1 << 3)
+#define joy_a      (1 << 4)
+#define joy_b      (1 << 5)
+#define joy_select (1 << 6)
+#define joy_start  (1 << 7)
+
+/* buttons held, 1 is pressed. directions are the low nibble of 0xff00 */
+struct joypad {
+    u8 buttons;
+    u8 pending;               /* from the joy command, taken at the next frame */
+    int has_pending;
+} joy;
+
+#define MOVIE_VERSION 1
+
+#define movie_joypad 'J'      /* buttons, then a varint run of frames */
+#define movie_serial 'S'      /* the byte a serial transfer clocked in */
+#define movie_end    'E'
+
+/*
+ * Inputs change only at frame boundaries, in frame_done(), so a movie is
+ * one joypad value per frame, stored as runs. A serial transfer ends the
+ * run so far and records its byte where it falls between them.
+ */
+struct movie {
+    FILE *f;
+    int recording;
+    u32 rom_hash;
+    u64 frames;
+    u8 value;
+    u64 run;
+} movie;
+
+struct ppu {
+    int mode;
+    int ly;           /* keeps counting while the lcd is off */
+    int window_line;
+    u64 frames;
+    u8 frame[SCREEN_H][SCREEN_W];  /* shades 0-3 after the palettes */
+} ppu;
+
+
+#define CPU_HZ    4194304
+#define SAMPLE_HZ 48000
+
+#define BLEP_TAPS   16
+#define BLEP_PHASES 32
+#define APU_BUF     4096
+
+typedef struct Channel {
+    int on;
+    int dac;
+    int length;
+    int length_on;
+    int volume;
+    int env_add;
+    int env_period;
+    int env_timer;
+    int freq;
+    int pos;          /* duty step or wave sample */
+    u16 lfsr;
+    u64 next_tick;
+    int left;         /* last level sent to each side, steps are the difference */
+    int right;
+} Channel;
+
+/*
+ * channels only catch up when a register is written or samples are
+ * wanted. level changes go into a band-limited step buffer at their
+ * exact cycle and come out resampled to SAMPLE_HZ.
+ */
+struct apu {
+    FILE *out;
+    u32 out_bytes;
+    Channel ch[4];
+    int sweep_period;
+    int sweep_timer;
+    int sweep_shadow;
+    int sweep_on;
+    u64 time;
+    u64 next_seq;
+    int seq_step;
+    u64 buf_start;            /* sample index of buf[x][0] */
+    i32 buf[2][APU_BUF + BLEP_TAPS];
+    i32 sum[2];
+    i32 hp_in[2];
+    i32 hp_out[2];
+    i16 kernel[BLEP_PHASES][BLEP_TAPS];
+} apu;
+
+
+/*
+ * Everything the next instruction depends on. The tile cache is rebuilt
+ * from vram and the apu output buffers are left alone.
+ */
+typedef struct Savestate {
+    struct CPU cpu;
+    union registers reg;
+    struct scheduler sched;
+    struct idle idle;
+    struct memory_map map;
+    struct cart cart;
+    struct timer timer;
+    struct joypad joy;
+    struct ppu ppu;
+    Channel ch[4];
+    int sweep[4];
+    u64 apu_time;
+    u64 apu_next_seq;
+    int apu_seq_step;
+    u8 memory[0x10000];
+    u8 *cart_ram;       /* allocated on the first save of a cart with ram */
+} Savestate;
+
+
+/* 8 bits at 8192 Hz, also how far one machine may run ahead of its peer */
+#define SERIAL_CYCLES 4096
+
+/*
+ * Two machines joined by a link cable. The running one is in the globals,
+ * the other in a Machine, and a switch swaps the two in place so neither
+ * loses its caches. Below $8000 the map points into the rom, so memory
+ * from there down is left out, and cart ram goes with the pointer in
+ * struct cart. A machine listening on the external clock runs at most a
+ * transfer's length past its peer; a master finishing a transfer waits
+ * until its peer has caught up to the same cycle, and the byte swap
+ * happens there.
+ */
+typedef struct Machine {
+    struct CPU cpu;
+    union registers reg;
+    struct scheduler sched;
+    struct idle idle;
+    struct memory_map map;
+    struct cart cart;
+    struct timer timer;
+    struct joypad joy;
+    struct ppu ppu;
+    struct tile_cache tiles;
+    Channel ch[4];
+    int sweep_period;
+    int sweep_timer;
+    int sweep_shadow;
+    int sweep_on;
+    u64 apu_time;
+    u64 apu_next_seq;
+    int apu_seq_step;
+    u8 *rom;
+    u32 rom_size;
+    u8 memory[0x8000];
+} Machine;
+
+struct cable {
+    int on;
+    int cur;                  /* machine in the globals */
+    Savestate boot;           /* power on state, before any rom */
+    Machine other;            /* the machine that isn't */
+    int waiting[2];           /* master with a byte to swap at cycle at[] */
+    u64 at[2];
+    u8 sc_before[2];          /* SC up to the last write to it, at cycle sc_at[] */
+    u64 sc_at[2];
+    int done[2];
+    int stop;                 /* the running machine should hand over */
+    int master;               /* it finished a transfer as master */
+} cable;
+
+
+#define COVER_EDGES (1 << 16)
+
+/*
+ * A block starts after any jump, call or return, taken or not, and where
+ * an interrupt lands. A rom address is its offset in the rom file,
+ * anything above 0x8000 goes after the rom.
+ */
+struct cover {
+    u8 ends[256];             /* opcodes that end a block */
+    u8 *blocks;               /* a bit per address */
+    u8 edges[COVER_EDGES];    /* hit counts of prev block ^ block */
+    u32 prev;
+} cover;
+
+#define MAX_CORPUS 4096
+#define MAX_LANES  16
+
+typedef struct Fuzz_Input {
+    u8 *joy;                  /* buttons per frame */
+} Fuzz_Input;
+
+struct fuzz {
+    u64 execs;
+    u64 rng;
+    Fuzz_Input corpus[MAX_CORPUS];
+    int corpus_len;
+    u8 seen[COVER_EDGES];     /* bucketed counts found so far */
+    u8 *input;
+    Savestate start;
+    int lanes;
+    u8 *lane_input[MAX_LANES];
+    Savestate fork;           /* where the lanes of a batch part ways */
+    u8 fork_edges[COVER_EDGES];
+    u32 fork_prev;
+} fuzz;
+
+
+#if defined(_WIN32)
+typedef HANDLE Thread;
+#else
+typedef pthread_t Thread;
+#endif
+
+#define DUMP_POOL 32
+
+typedef struct Dump_Frame {
+    u64 number;
+    u8 px[SCREEN_H][SCREEN_W];
+} Dump_Frame;
+
+/* single producer, single consumer */
+typedef struct Frame_Ring {
+    Dump_Frame *slot[DUMP_POOL];
+    atomic_uint head;
+    atomic_uint tail;
+} Frame_Ring;
+
+#define LIST_OF_DUMP_FORMATS \
+    X(none) \
+    X(rgb) \
+    X(ppm) \
+    X(y4m) \
+    X(end)
+
+typedef enum Dump_Format {
+#define X(name) dump_##name,
+    LIST_OF_DUMP_FORMATS
+#undef X
+} Dump_Format;
+
+/*
+ * Frames are copied into pool buffers at vblank and handed to a writer
+ * thread, which hashes, encodes and writes them then hands the buffers
+ * back on the free ring.
+ */
+struct dump {
+    int on;
+    Dump_Format format;
+    const char *path;        /* contains a %d for a ppm sequence */
+    FILE *out;
+    FILE *hashes;
+    Frame_Ring full;
+    Frame_Ring free;
+    atomic_int done;
+    Thread writer;
+    Dump_Frame pool[DUMP_POOL];
+} dump;
+
+#define MAX_BREAKS  64
+#define MAX_WATCHES 64
+
+#define watch_read  (1 << 0)
+#define watch_write (1 << 1)
+
+#define LIST_OF_COMMANDS \
+    X(break) \
+    X(watch) \
+    X(delete) \
+    X(print) \
+    X(joy) \
+    X(stats) \
+    X(search) \
+    X(cheat) \
+    X(heat) \
+    X(continue)
+
+#define COND_LEN   16
+#define COND_STACK 8
+
+#define LIST_OF_COND_OPS \
+    X(push, "") \
+    X(r8,   "") \
+    X(r16,  "") \
+    X(peek, "") \
+    X(deref_r16, "") \
+    X(add,  "+") \
+    X(sub,  "-") \
+    X(and,  "&") \
+    X(or,   "|") \
+    X(eq,   "==") \
+    X(ne,   "!=") \
+    X(lt,   "<") \
+    X(gt,   ">") \
+    X(le,   "<=") \
+    X(ge,   ">=") \
+    X(end,  "")
+
+typedef enum Cond_Op {
+#define X(name, sym) cond_##name,
+    LIST_OF_COND_OPS
+#undef X
+} Cond_Op;
+
+/* rpn compiled once, arg is a constant, an address or an offset into reg */
+typedef struct Cond_Insn {
+    u8 op;
+    u16 arg;
+} Cond_Insn;
+
+typedef struct Cond {
+    int len;          /* 0 is always true */
+    Cond_Insn code[COND_LEN];
+} Cond;
+
+typedef struct Breakpoint {
+    u16 addr;
+    Cond cond;
+} Breakpoint;
+
+typedef struct Watchpoint {
+    u16 lo;
+    u16 hi;
+    int kind;
+    Cond cond;
+} Watchpoint;
+
+#define LIST_OF_SEARCH_OPS \
+    X(start) \
+    X(eq) \
+    X(same) \
+    X(changed) \
+    X(up) \
+    X(down) \
+    X(word) \
+    X(list) \
+    X(end)
+
+typedef enum Search_Op {
+#define X(name) search_##name,
+    LIST_OF_SEARCH_OPS
+#undef X
+} Search_Op;
+
+const char *search_op_names[] = {
+#define X(name) #name,
+    LIST_OF_SEARCH_OPS
+#undef X
+};
+
+/* cart ram and wram are one run from $a000, hram follows */
+#define SEARCH_LOW   0x4000
+#define SEARCH_BYTES (SEARCH_LOW + 0x80)
+#define SEARCH_SHOW  16
+
+/*
+ * Value hunting. Each filter compares memory with the last snapshot 16
+ * bytes at a time, one bit per address stays set while it still matches.
+ */
+struct search {
+    u8 old[SEARCH_BYTES + 16];
+    u8 cur[SEARCH_BYTES + 16];    /* padded for the word compare */
+    u64 bits[SEARCH_BYTES / 64];
+    int started;
+} search;
+
+/*
+ * Only pages holding a breakpoint or watchpoint get a trap bit in the
+ * memory map, the lists are searched after one of those bits is seen.
+ */
+struct debug {
+    Breakpoint breaks[MAX_BREAKS];
+    int num_breaks;
+    Watchpoint watches[MAX_WATCHES];
+    int num_watches;
+    int paused;
+} debug;
+
+/*
+ * Build with -DGB_HOOKS=1 to get callbacks for instrumentation. Without
+ * it the hook() calls are empty and nothing is checked. Loops skipped by
+ * the idle fast forward don't call the instruction hook, use -no-ff when
+ * every instruction has to be seen.
+ */
+#if GB_HOOKS
+struct hooks {
+    void *ctx;
+    void (*instruction)(void *ctx, u16 pc, u8 *code);
+    void (*read)(void *ctx, u16 addr, u8 v);
+    void (*write)(void *ctx, u16 addr, u8 v);
+    void (*interrupt)(void *ctx, int i);
+    void (*frame)(void *ctx, u64 frame);
+} hooks;
+
+#define hook(name, ...) \
+    do { \
+        if (hooks.name) \
+            hooks.name(hooks.ctx, __VA_ARGS__); \
+    } while (0)
+#else
+#define hook(name, ...) \
+    do { \
+    } while (0)
+#endif
+
+#define STREAM_VERSION 1
+
+/*
+ * A state hash per frame, or per `every` instructions, for comparing two
+ * builds. Pages are rehashed only when written, rom pages by their bank.
+ */
+struct stream {
+    FILE *out;
+    u64 every;
+    u64 count;
+    u64 index;                /* the interval being run */
+    u64 page[0x100];
+    i64 trace;                /* interval to trace, -1 for none */
+} stream;
+
+#define CHECK_CONTEXT 4
+#define CHECK_BUF     (1 << 20)
+
+/* a reference trace in gameboy-doctor's layout, compared as we go */
+struct check {
+    FILE *in;
+    u64 line;
+    char text[CHECK_CONTEXT][128];   /* the last reference lines, for context */
+    u16 pc[CHECK_CONTEXT];           /* and the instructions that ran after them */
+    u8 code[CHECK_CONTEXT][3];
+} check;
+
+/* work done after each instruction, only looked at when one is on */
+#define step_cover (1 << 0)
+#define step_count (1 << 1)
+#define step_trace (1 << 2)
+#define step_check (1 << 3)
+#define step_heat  (1 << 4)
+
+#define LIST_OF_HEAT \
+    X(read) \
+    X(write) \
+    X(fetch) \
+    X(end)
+
+typedef enum Heat {
+#define X(name) heat_##name,
+    LIST_OF_HEAT
+#undef X
+} Heat;
+
+const char *heat_names[] = {
+#define X(name) #name,
+    LIST_OF_HEAT
+#undef X
+};
+
+/*
+ * Accesses per 256 byte page. Banked rom pages are counted by their
+ * offset in the rom, then come the 256 pages of the address space as
+ * they are, and one more for hram since it shares a page with io.
+ */
+struct heat {
+    int on;
+    int rom_pages;
+    int num_pages;
+    u64 *count[heat_end];
+    const char *table_path;
+    const char *ppm_path;
+} heat;
+
+#define LIST_OF_STAGES \
+    X(read) \
+    X(rpn) \
+    X(lookup_word) \
+    X(lookup_opcode) \
+    X(assemble) \
+    X(eval) \
+    X(print) \
+    X(line) \
+    X(end)
+
+typedef enum Stage {
+#define X(name) stage_##name,
+    LIST_OF_STAGES
+#undef X
+} Stage;
+
+const char *stage_names[] = {
+#define X(name) #name,
+    LIST_OF_STAGES
+#undef X
+};
+
+/* log-linear buckets, 16 per power of two, like hdr histograms */
+#define HIST_SUB     16
+#define HIST_BUCKETS (64 * HIST_SUB)
+
+/* repl latency per stage in ticks, stages include the ones they call */
+struct latency {
+    u32 count[stage_end][HIST_BUCKETS];
+    u64 n[stage_end];
+    u64 max[stage_end];
+    u64 tick0;
+    u64 ns0;
+} latency;
+
+#define timed(stage, stmt) \
+    do { \
+        u64 t0_ = ticks(); \
+        stmt; \
+        latency_add(stage_##stage, ticks() - t0_); \
+    } while (0)
+
+#define LIVE_ROWS 24
+#define LIVE_COLS 256
+#define LIVE_CODE 12   /* instructions in the disassembly pane */
+#define LIVE_MEM  8    /* rows of 16 bytes in the memory pane */
+
+/* full screen view, redrawn from frame_done at most hz times a second */
+struct live {
+    int on;
+    volatile int quit;
+    u64 period;         /* ns between redraws */
+    u64 next;
+    u64 last_ns;
+    u64 last_frames;
+    double fps;
+    union registers old;
+    FILE *scratch;      /* Code_print writes to a FILE */
+    char rows[2][LIVE_ROWS][LIVE_COLS];
+    int front;
+    int full;           /* next redraw repaints every row */
+} live;
+
 struct settings {
     int echo_bytes;
     int num_words;
     int reading_rom;
+    int disassemble;
+    int no_fast_forward;
+    int no_render;          /* nothing looks at the screen */
+    int step_extras;
+    int start_paused;
+    u64 frames;
     Dict dict;
 } global;
 
 
+#define DIS_CODE    (1 << 0)
+#define DIS_OPERAND (1 << 1)
+#define DIS_LABEL   (1 << 2)
+
+typedef struct Disasm_Job {
+    u32 offset;
+    u16 bank;  /* bank mapped at $4000 when the job was queued */
+} Disasm_Job;
+
+struct disasm {
+    u8 *flags;  /* DIS_* per rom byte, also memoises what has been decoded */
+    Disasm_Job *jobs;
+    int num_jobs;
+    int max_jobs;
+} dis;
+
+
 /* ##### */
 
 void Code_repr(u8 *code);
+void Code_print(FILE *f, u8 *code, u16 pc);
+const char *io_port_name(u8 port);
+Opcode *Opcode_from_code(u8 *code);
 
 Keyword Keyword_from_string(const char *);
 void Keyword_repr(Keyword k);
@@ -305,13 +1085,18 @@ int u8_from_object(u8 *i, Object *o);
 void Object_repr(Object *o);
 
 void chomp(char **in, char c);
+int str_eq(const char *s1, const char *s2);
+int str_ends_with(const char *s, const char *suffix);
 int read_token(char *dst, const char *src, size_t n);
 
 u8 peek8(u16 addr);
 u8* peek8ptr(u16 addr);
+void poke8(u16 addr, u8 v);
+void push16(u16 v);
+u16 pop16(void);
+int condition_met(u8 k);
 void init(void);
 void print_header(int indent);
-void print_line_prefix(void);
 int parse_number(i32 *n, const char *arg);
 int parse_addr(u16 *addr, const char *arg);
 int parse_u8(u8 *n, const char *arg);
@@ -326,8 +1111,186 @@ void eval_string(char *x, int echo);
 void assemble(u8 *code, const char *cmd, const char *args);
 void eval(u8 *code, int echo);
 
+void load_rom(const char *path);
+
+void map_init(void);
+void map_rom_bank(int bank);
+void write_hook(u16 addr, u8 v);
+u8   read_hook(u16 addr);
+u8   io_read(u16 addr);
+u8   io_peek(u16 addr);
+void mbc_write(u16 addr, u8 v);
+void vram_write(u16 addr, u8 v);
+void io_write(u16 addr, u8 v);
+void oam_dma(u8 page);
+
+int  timer_period(void);
+void timer_sync(void);
+void timer_schedule(void);
+
+void schedule(Event e, u64 at);
+void run_events(void);
+void interrupts(void);
+void idle_check(void);
+void step(int echo);
+
+void ppu_mode(int mode);
+void ppu_line(int ly);
+void ppu_event(void);
+void decode_tile_row(u8 lo, u8 hi, u8 *out);
+u8  *tile_row(int tile, int row, int flip);
+void render_tiles(u8 *out, u16 map_base, int y, int first_tile, u8 lcdc);
+void render_line(int ly);
+void frame_done(void);
+u64  frame_hash(u8 *px);
+
+void apu_init(void);
+void apu_open(const char *path);
+void apu_close(void);
+void apu_write(u16 addr, u8 v);
+void apu_trigger(int c);
+int  apu_period(int c);
+int  apu_level(int c);
+void apu_mix(int c, u64 time);
+void apu_delta(int side, u64 time, int delta);
+void apu_sequencer(void);
+void apu_run_to(u64 end);
+void apu_status(void);
+void apu_drain(void);
+void apu_flush(void);
+
+int  thread_start(Thread *t, void *(*fn)(void *), void *arg);
+void thread_join(Thread t);
+void thread_sleep(void);
+
+int  ring_push(Frame_Ring *r, Dump_Frame *f);
+Dump_Frame *ring_pop(Frame_Ring *r);
+void dump_open(const char *path, const char *hashes);
+void dump_frame(void);
+void dump_write(Dump_Frame *f);
+void *dump_writer(void *arg);
+void dump_close(void);
+
+int  cond_compile(Cond *c, const char *x);
+i32  cond_eval(Cond *c);
+
+void joypad_set(u8 buttons);
+
+u32  rom_hash(void);
+void movie_open(const char *path, int recording);
+void movie_frame(void);
+void movie_put(void);
+u64  movie_varint(void);
+u8   movie_serial_in(u8 in);
+void movie_close(void);
+
+void state_save(Savestate *st);
+void state_load(Savestate *st);
+
+void cover_open(void);
+void step_extras(u16 pc, u8 *code);
+void cover_step(u16 pc, u8 *code);
+void cover_block(u16 pc);
+u64  fuzz_rand(void);
+void fuzz_mutate(u8 *input, int from, int frames);
+void fuzz_frames(u8 *input, int from, int to);
+int  fuzz_novel(void);
+void fuzz_keep(u8 *input, int frames);
+int  fuzz_exec(u8 *input, int frames);
+void fuzz_batch(int frames);
+void fuzz_run(u64 execs, int frames);
+
+u64  state_hash(void);
+u64  page_hash(u8 *p);
+void stream_open(const char *path, u64 every);
+void stream_mark(void);
+void stream_close(void);
+void trace_line(FILE *f);
+int  bisect(char **argv);
+int  bisect_streams(const char *a, const char *b, u64 *index);
+void bisect_run(const char *build, char **args, const char *opt, const char *value, const char *out);
+int  bisect_traces(const char *a, const char *b, u64 index);
+void trace_fields(u8 *out);
+void check_open(const char *path);
+void check_step(u16 pc, u8 *code);
+void check_close(void);
+void serve(i32 until_pc, u64 frames);
+void serve_job(char *line);
+
+u64  mono_ns(void);
+u64  ticks(void);
+int  hist_bucket(u64 v);
+u64  hist_value(int b);
+void latency_add(Stage s, u64 dt);
+u64  latency_percentile(Stage s, double p);
+void latency_dump(void);
+
+void print_line_prefix(void);
+int  format_line_prefix(char *out, union registers *old);
+void live_open(int hz);
+void live_close(void);
+void live_quit(int sig);
+void live_frame(void);
+void live_draw(void);
+
+u16  search_addr(int i);
+void search_read(u8 *out);
+u32  search_mask(Search_Op op, u8 *cur, u8 *old, u8 lo, u8 hi, int any);
+u64  search_count(void);
+void search_show(int max);
+
+u8  *rom_page(u32 offset);
+void map_rom(void);
+int  hex_digits(u8 *out, const char *s, int n);
+int  cheat_add(const char *code);
+void cheat_patch(Patch *p);
+void cheat_clear(void);
+void cheat_freeze(void);
+
+void map_cart_ram(void);
+void sav_open(const char *path, int private);
+void sav_flush(int wait);
+void sav_close(void);
+
+void serial_event(void);
+void serial_finish(u8 in);
+void link_open(const char *path);
+void swap_bytes(void *a, void *b, size_t n);
+void link_switch(int to);
+u64  link_cycles(int k);
+u8  *link_io(int k);
+int  link_listening(int k, u64 t);
+u64  link_bound(int k);
+int  link_runnable(int k);
+void link_exchange(int master);
+void link_run(u64 frames);
+
+void heat_open(void);
+int  heat_page(u16 addr);
+const char *heat_region(int page, char *name);
+void heat_table(FILE *f);
+void heat_ppm(const char *path);
+void heat_close(void);
+
+void debug_map(void);
+void debug_break(u16 pc);
+void debug_watch(u16 addr, int kind);
+void debug_repl(void);
+int  debug_command(const char *word, char *args);
+#define X(name) void cmd_##name(char *args);
+    LIST_OF_COMMANDS
+#undef X
+
+i32  disasm_offset(u16 addr, int bank);
+void disasm_queue(u16 addr, int bank);
+void disasm_trace(Disasm_Job job);
+void disasm_print(FILE *f);
+void disasm(void);
+
 /* ##### */
 
+#include "cb-kernels.h"
+
 
 Keyword
 Keyword_from_string(const char *s)
@@ -672,12 +1635,70 @@ read_token(char *dst, const char *src, size_t n)
 
 u8
 peek8(u16 addr) {
-    return *peek8ptr(addr);
+    u8 v = map.attr[addr >> 8] & page_read_slow ? read_hook(addr) : *peek8ptr(addr);
+    hook(read, addr, v);
+    return v;
 }
 
 u8*
 peek8ptr(u16 addr) {
-    return &memory[addr];
+    return &map.page[addr >> 8][addr & 0xff];
+}
+
+void
+poke8(u16 addr, u8 v) {
+    cpu.writes += 1;
+    map.dirty[addr >> 8] = true;
+    hook(write, addr, v);
+    if (map.attr[addr >> 8] & page_write_slow) {
+        write_hook(addr, v);
+        return;
+    }
+    map.page[addr >> 8][addr & 0xff] = v;
+}
+
+
+void
+push16(u16 v)
+{
+    reg.wr.sp -= 2;
+    poke8(reg.wr.sp + 0, (u8)(v >> 0));
+    poke8(reg.wr.sp + 1, (u8)(v >> 8));
+}
+
+
+u16
+pop16(void)
+{
+    u16 v = 0;
+    v  = peek8(reg.wr.sp + 0) << 0;
+    v += peek8(reg.wr.sp + 1) << 8;
+    reg.wr.sp += 2;
+    return v;
+}
+
+
+int
+condition_met(u8 k)
+{
+    switch (k) {
+    case keyword_z:
+        return flag_z(reg.br.f);
+
+    case keyword_nz:
+        return !flag_z(reg.br.f);
+
+    case keyword_cy:
+        return flag_cy(reg.br.f);
+
+    case keyword_nc:
+        return !flag_cy(reg.br.f);
+
+    default:
+        Keyword_repr(k);
+        die("not a condition");
+    }
+    return false;
 }
 
 
@@ -701,10 +1722,31 @@ init(void)
     reg.wr.de = 0;
     reg.wr.hl = 0;
 
+    reg.wr.sp = 0xfffe;
     reg.wr.pc = 0x100;
 
     memcpy(&prev_reg, &reg, sizeof(reg));
 
+    map_init();
+    apu_init();
+
+    /* io state left behind by the boot rom */
+    memory[io_lcdc] = 0x91;
+    memory[io_stat] = 0x80 | 2;
+    memory[io_bgp]  = 0xfc;
+    memory[0xff24]  = 0x77;
+    memory[0xff25]  = 0xf3;
+    memory[0xff26]  = 0xf1;
+    /* the boot sound has faded out but channel 1 is still on */
+    apu.ch[0].on = true;
+    apu.ch[0].dac = true;
+
+    cpu.cycles = 0;
+    for (int i = 0; i < event_end; i += 1)
+        sched.at[i] = (u64)-1;
+    ppu.mode = 2;
+    schedule(event_ppu, 80);
+
     Dict_init(&global.dict);
     Dict_add_fn(&global.dict, "+", Stack_add);
 
@@ -742,57 +1784,75 @@ print_header(int indent)
 void
 print_line_prefix(void)
 {
+    char line[256];
+
+    format_line_prefix(line, &prev_reg);
+    printf("%s", line);
+
+    prev_reg.wr.deref_hl = reg.wr.deref_hl;
+}
+
+
+int
+format_line_prefix(char *out, union registers *old)
+{
+    char *p = out;
+
+#define put(...) p += sprintf(p, __VA_ARGS__)
 #define highlight_diff(new, old) \
     do { \
         if (new != old) { \
-            printf(ESC "[" WHITE_TEXT "m"); \
+            put(ESC "[" WHITE_TEXT "m"); \
         } else { \
-            printf(ESC "[" BRIGHT_BLACK_TEXT "m"); \
+            put(ESC "[" BRIGHT_BLACK_TEXT "m"); \
         } \
     } while(0)
 
-    highlight_diff(reg.br.a, prev_reg.br.a);
-    printf(" %02x ", reg.br.a);
-
-    highlight_diff(flag_z(reg.br.f), flag_z(prev_reg.br.f));
-    printf("%c", flag_z(reg.br.f) ? 'z' : '-');
-    highlight_diff(flag_n(reg.br.f), flag_n(prev_reg.br.f));
-    printf("%c", flag_n(reg.br.f) ? 'z' : '-');
-    highlight_diff(flag_h(reg.br.f), flag_h(prev_reg.br.f));
-    printf("%c", flag_h(reg.br.f) ? 'z' : '-');
-    highlight_diff(flag_cy(reg.br.f), flag_cy(prev_reg.br.f));
-    printf("%c", flag_cy(reg.br.f) ? 'z' : '-');
-
-    highlight_diff(reg.br.b, prev_reg.br.b);
-    printf(" %02x", reg.br.b);
-    highlight_diff(reg.br.c, prev_reg.br.c);
-    printf("%02x", reg.br.c);
-
-    highlight_diff(reg.br.d, prev_reg.br.d);
-    printf(" %02x", reg.br.d);
-    highlight_diff(reg.br.e, prev_reg.br.e);
-    printf("%02x", reg.br.e);
-
-    highlight_diff(reg.br.h, prev_reg.br.h);
-    printf(" %02x", reg.br.h);
-    highlight_diff(reg.br.l, prev_reg.br.l);
-    printf("%02x", reg.br.l);
-
-    reg.wr.deref_hl = peek8(reg.wr.hl);
-    highlight_diff(reg.wr.deref_hl, prev_reg.wr.deref_hl);
-    printf("  %02x", reg.wr.deref_hl);
+    highlight_diff(reg.br.a, old->br.a);
+    put(" %02x ", reg.br.a);
+
+    highlight_diff(flag_z(reg.br.f), flag_z(old->br.f));
+    put("%c", flag_z(reg.br.f) ? 'z' : '-');
+    highlight_diff(flag_n(reg.br.f), flag_n(old->br.f));
+    put("%c", flag_n(reg.br.f) ? 'z' : '-');
+    highlight_diff(flag_h(reg.br.f), flag_h(old->br.f));
+    put("%c", flag_h(reg.br.f) ? 'z' : '-');
+    highlight_diff(flag_cy(reg.br.f), flag_cy(old->br.f));
+    put("%c", flag_cy(reg.br.f) ? 'z' : '-');
+
+    highlight_diff(reg.br.b, old->br.b);
+    put(" %02x", reg.br.b);
+    highlight_diff(reg.br.c, old->br.c);
+    put("%02x", reg.br.c);
+
+    highlight_diff(reg.br.d, old->br.d);
+    put(" %02x", reg.br.d);
+    highlight_diff(reg.br.e, old->br.e);
+    put("%02x", reg.br.e);
+
+    highlight_diff(reg.br.h, old->br.h);
+    put(" %02x", reg.br.h);
+    highlight_diff(reg.br.l, old->br.l);
+    put("%02x", reg.br.l);
+
+    /* straight from the page, showing it mustn't set off watches or io reads */
+    reg.wr.deref_hl = *peek8ptr(reg.wr.hl);
+    highlight_diff(reg.wr.deref_hl, old->wr.deref_hl);
+    put("  %02x", reg.wr.deref_hl);
 
     /* todo highlight bank */
-    printf(ESC "[" BRIGHT_BLACK_TEXT "m");
-    printf("  %4s", "rom0");
+    put(ESC "[" BRIGHT_BLACK_TEXT "m");
+    put("  %4s", "rom0");
 
-    printf(":");
-    highlight_diff(reg.wr.pc, prev_reg.wr.pc);
-    printf("%04x", reg.wr.pc);
+    put(":");
+    highlight_diff(reg.wr.pc, old->wr.pc);
+    put("%04x", reg.wr.pc);
 
-    printf("   " RESET);
+    put("   " RESET);
 
-    prev_reg.wr.deref_hl = reg.wr.deref_hl;
+#undef highlight_diff
+#undef put
+    return p - out;
 }
 
 
@@ -873,6 +1933,8 @@ eval_string(char *x, int echo)
     char *spacer = NULL;
     Opcode *op = NULL;
 
+    u64 start = ticks();
+
     chomp(&in, ' ');
     if (*in == '\n' || *in == '\0')
         return;
@@ -880,17 +1942,23 @@ eval_string(char *x, int echo)
     if (echo)
         printf("%s", x);
 
-    in += read_token(word, in, sizeof(word));
-    chomp(&in, ' ');
+    timed(read, in += read_token(word, in, sizeof(word)); chomp(&in, ' '));
     /*ere;*/
     /*debug_var("s", x);*/
 
-    assemble(code, word, in);
-    eval(code, false);
+    if (debug_command(word, in)) {
+        latency_add(stage_line, ticks() - start);
+        return;
+    }
+
+    timed(assemble, assemble(code, word, in));
+    timed(eval, eval(code, false));
 
     if (global.echo_bytes) {
+        u64 t0 = ticks();
+
         printf("%38s", "");
-        op = &opcode_table[code[0]];
+        op = Opcode_from_code(code);
 
         printf(ESC "[" BRIGHT_BLACK_TEXT "m");
         for (i = 0; i < op->bytes; i += 1) {
@@ -898,7 +1966,9 @@ eval_string(char *x, int echo)
             printf("%02x%s", code[i], spacer);
         }
         printf(RESET "\n");
+        latency_add(stage_print, ticks() - t0);
     }
+    latency_add(stage_line, ticks() - start);
 }
 
 
@@ -1009,6 +2079,18 @@ invalid_argument(Object *o, Keyword k)
             return true;
         return strcmp(keyword_names[k], o->name);
 
+    case keyword_0:
+    case keyword_1:
+    case keyword_2:
+    case keyword_3:
+    case keyword_4:
+    case keyword_5:
+    case keyword_6:
+    case keyword_7:
+        if (o->type != type_i32)
+            return true;
+        return o->i != (i32)(k - keyword_0);
+
     case keyword_deref_u8:
         if (o->type != type_i32)
             return true;
@@ -1060,7 +2142,11 @@ lookup_opcode(Keyword k, Stack *s, Opcode **o)
     /*ere;*/
     /*debug_var("d", s->length - 1);*/
 
-    for (int i = num_opcodes; i; i -= 1, op += 1) {
+    /* the cb-prefixed table is searched after the main one */
+    for (int i = 2 * num_opcodes; i; i -= 1, op += 1) {
+        if (i == num_opcodes)
+            op = cb_opcode_table;
+
         int num_args = op->num_words > 0 ? op->num_words - 1 : 0;
         /*ere;*/
         /*debug_var("d", op->num_words);*/
@@ -1108,6 +2194,7 @@ eval_rpn(Stack *s, const char *x)
     char *w;
     const char *in = x;
     i32 l = 0;
+    int missing = 0;
 
     while (*in != '\n' && *in != '\0') {
         Object o;
@@ -1121,7 +2208,8 @@ eval_rpn(Stack *s, const char *x)
                 w += 1;
                 /*debug_var("s", w);*/
                 if (parse_number(&l, w)) {
-                    if(lookup_word(&o, w)) {
+                    timed(lookup_word, missing = lookup_word(&o, w));
+                    if (missing) {
                         debug_var("s", w);
                         die("error");
                     }
@@ -1150,7 +2238,8 @@ eval_rpn(Stack *s, const char *x)
 
             default:
                 if (parse_number(&l, tok)) {
-                    if(lookup_word(&o, tok)) {
+                    timed(lookup_word, missing = lookup_word(&o, tok));
+                    if (missing) {
                         debug_var("s", tok);
                         die("error");
                     }
@@ -1186,15 +2275,17 @@ assemble(u8 *code, const char *cmd, const char *args)
     Object arg2 = {type_nil};
 
     Stack s;
+    int missing = 0;
     Stack_init(&s);
-    eval_rpn(&s, args);
+    timed(rpn, eval_rpn(&s, args));
     /*ere;*/
     /*Stack_repr(&s);*/
 
     Keyword k = Keyword_from_string(cmd);
     Opcode *op = NULL;
 
-    if (lookup_opcode(k, &s, &op)) {
+    timed(lookup_opcode, missing = lookup_opcode(k, &s, &op));
+    if (missing) {
         ere;
         Stack_repr(&s);
         debug_var("s", cmd);
@@ -1224,7 +2315,12 @@ assemble(u8 *code, const char *cmd, const char *args)
 
     /*debug_var("d", op->num_operands);*/
 
-    *(code+0) = op->code;
+    if (op->prefixed) {
+        *(code+0) = 0xcb;
+        *(code+1) = op->code;
+    } else {
+        *(code+0) = op->code;
+    }
 
     switch (op->num_operands) {
     case 0:
@@ -1298,6 +2394,14 @@ assemble(u8 *code, const char *cmd, const char *args)
         case keyword_cy:
         case keyword_nc:
         case keyword_deref_hl:
+        case keyword_0:
+        case keyword_1:
+        case keyword_2:
+        case keyword_3:
+        case keyword_4:
+        case keyword_5:
+        case keyword_6:
+        case keyword_7:
             break;
 
         case keyword_deref_u8:
@@ -1325,6 +2429,12 @@ assemble(u8 *code, const char *cmd, const char *args)
 
         switch (op->words[2]) {
         case keyword_a:
+        case keyword_b:
+        case keyword_c:
+        case keyword_d:
+        case keyword_e:
+        case keyword_h:
+        case keyword_l:
         case keyword_bc:
         case keyword_de:
         case keyword_hl:
@@ -1373,31 +2483,78 @@ assemble(u8 *code, const char *cmd, const char *args)
 }
 
 
+Opcode *
+Opcode_from_code(u8 *code)
+{
+    if (*code == 0xcb)
+        return &cb_opcode_table[*(code+1)];
+    return &opcode_table[*code];
+}
+
+
 void
 Code_repr(u8 *code)
 {
-    Opcode *o = &opcode_table[*code];
+    Code_print(stderr, code, reg.wr.pc);
+}
+
+
+const char *
+io_port_name(u8 port)
+{
+    switch (port) {
+    case 0x00: return "joypad";
+    case 0x01: return "serial data";
+    case 0x02: return "serial control";
+    case 0x04: return "DIV";
+    case 0x05: return "TIMA";
+    case 0x06: return "TMA";
+    case 0x07: return "TAC";
+    case 0x0f: return "int flag";
+    case 0x40: return "lcd control";
+    case 0x41: return "lcd stat";
+    case 0x42: return "scroll Y";
+    case 0x43: return "scroll X";
+    case 0x44: return "LY";
+    case 0x45: return "LYC";
+    case 0x46: return "OAM DMA";
+    case 0x47: return "BG palette";
+    case 0x48: return "OBJ palette 0";
+    case 0x49: return "OBJ palette 1";
+    case 0x4a: return "window Y";
+    case 0x4b: return "window X";
+    case 0xff: return "int enable";
+    default:   return NULL;
+    }
+}
+
+
+void
+Code_print(FILE *f, u8 *code, u16 pc)
+{
+    Opcode *o = Opcode_from_code(code);
     int i = 0;
     u8 *c = code;
     u8  d8  = 0;
     u16 d16 = 0;
     i8  r8 = 0;
     char *sep = "";
-    char *comment = "";
+    char comment[TOKEN_LEN] = "";
+    const char *port = NULL;
 
     for (i = 0; i < 3; i += 1) {
         if (i < o->bytes) {
-            fprintf(stderr, "%s%02x", sep, *c);
+            fprintf(f, "%s%02x", sep, *c);
             c += 1;
         } else {
-            fprintf(stderr, "%s  ", sep);
+            fprintf(f, "%s  ", sep);
         }
         sep = " ";
     }
-    fprintf(stderr, " ");
+    fprintf(f, " ");
 
     char *prefix = "";
-    fprintf(stderr, "%s", keyword_names[o->words[0]]);
+    fprintf(f, "%s", keyword_names[o->words[0]]);
 
     sep = " ";
     for (int i = 0; i < o->num_operands; i += 1) {
@@ -1416,19 +2573,32 @@ Code_repr(u8 *code)
 
         case keyword_hl:
 
-        case keyword_deref_hl:
-
         case keyword_z:
         case keyword_nz:
         case keyword_cy:
         case keyword_nc:
 
+        case keyword_0:
+        case keyword_1:
+        case keyword_2:
+        case keyword_3:
+        case keyword_4:
+        case keyword_5:
+        case keyword_6:
+        case keyword_7:
+
         case keyword_nop:
             break;
 
         case keyword_r8:
             r8  = *(code + 1) << 0;
-            d16 = reg.wr.pc + r8 + o->bytes;
+            if (o->words[0] != keyword_jr) {
+                /* ld hl, sp+r8 */
+                snprintf(arg_buffer, TOKEN_LEN - 1, "%+d", r8);
+                name = arg_buffer;
+                break;
+            }
+            d16 = pc + r8 + o->bytes;
             snprintf(arg_buffer, TOKEN_LEN - 1, "$%04x", d16);
             name = arg_buffer;
             break;
@@ -1439,51 +2609,8 @@ Code_repr(u8 *code)
             snprintf(arg_buffer, TOKEN_LEN - 1, "$%04x", d16);
             name = arg_buffer;
 
-            switch (d8) {
-                case 0x01:
-                    comment = "  ;serial data";
-                    break;
-
-                case 0x02:
-                    comment = "  ;serial control";
-                    break;
-
-                case 0x0f:
-                    comment = "  ;int flag";
-                    break;
-
-                case 0x40:
-                    comment = "  ;lcd control";
-                    break;
-
-                case 0x41:
-                    comment = "  ;lcd stat";
-                    break;
-
-                case 0x42:
-                    comment = "  ;scroll Y";
-                    break;
-
-                case 0x43:
-                    comment = "  ;scroll X";
-                    break;
-
-                case 0x44:
-                    comment = "  ;LY";
-                    break;
-
-                case 0xa4:
-                    comment = "";
-                    break;
-
-                case 0xff:
-                    comment = "  ;int enable";
-                    break;
-
-                default:
-                    debug_var("02x", d8);
-                    die("ere");
-            }
+            if ((port = io_port_name(d8)))
+                snprintf(comment, TOKEN_LEN - 1, "  ;%s", port);
             break;
 
         case keyword_u8:
@@ -1493,6 +2620,7 @@ Code_repr(u8 *code)
             break;
 
         case keyword_u16:
+        case keyword_deref_u16:
             d16  = *(code + 1) << 0;
             d16 += *(code + 2) << 8;
             snprintf(arg_buffer, TOKEN_LEN - 1, "$%04x", d16);
@@ -1500,24 +2628,25 @@ Code_repr(u8 *code)
             break;
 
         default:
-            fprintf(stderr, "\n");
-            Keyword_repr(k);
-            die("unknown keyword");
+            /* registers, rst vectors and the *r16 forms print as named */
+            if (!strncmp(name, "deref_", 6))
+                name += 6;
+            break;
         }
 
         if (o->immediate) {
             prefix = "";
-        } else if (o->operands[i].immediate) {
+        } else if (i >= 2 || o->operands[i].immediate) {
             prefix = "";
         } else {
             /*name += 6;*/
             prefix = "*";
         }
 
-        fprintf(stderr, "%s%s%s", sep, prefix, name);
+        fprintf(f, "%s%s%s", sep, prefix, name);
         sep = ", ";
     }
-    fprintf(stderr, "%s\n", comment);
+    fprintf(f, "%s\n", comment);
 }
 
 
@@ -1530,24 +2659,31 @@ eval(u8 *code, int echo)
     u16  d16 = 0;
     u8  *dst8 = NULL;
     u16 *dst16 = NULL;
+    u8   mem8 = 0;
+    int write = false;
+    int cycles = 0;
     int cp_result = 0;
+    int step = 0;
     /*debug_var("x", *(code+0));*/
     /*debug_var("x", *(code+1));*/
     /*debug_var("x", *(code+2));*/
     /*debug_var("x", *(code+3));*/
     memcpy(&prev_reg, &reg, sizeof(reg));
-    Opcode *op = &opcode_table[*code];
+    Opcode_Info *op = &opcode_info[*code];
 
     if (echo)
         Code_repr(code);
 
-    if (*code == 0) {
-        /* nop */
+    cycles = op->cycles;
 
-    } else if (op->words[0] == keyword_ld) {
+    switch (op->handler) {
+    case handler_nop:
+        break;
+
+    case handler_ld:
         /*Opcode_repr(op);*/
         /*debug_var("d", op->immediate);*/
-        switch (op->words[1]) {
+        switch (op->dst) {
         case keyword_a:
             dst8 = &reg.br.a;
             break;
@@ -1591,21 +2727,23 @@ eval(u8 *code, int echo)
         case keyword_deref_u16:
             addr  = *(code+1) << 0;
             addr += *(code+2) << 8;
-            dst8 = peek8ptr(addr);
+            dst8 = &mem8;
+            write = true;
             break;
 
         case keyword_deref_hl:
             addr = reg.wr.hl;
-            dst8 = peek8ptr(addr);
+            dst8 = &mem8;
+            write = true;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("unknown keyword");
         }
 
-        switch (op->words[2]) {
+        switch (op->src) {
         case keyword_a:
             *dst8 = reg.br.a;
             break;
@@ -1628,12 +2766,14 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Keyword_repr(op->words[2]);
+            Keyword_repr(op->src);
             die("other");
         }
 
-    } else if (op->words[0] == keyword_ldh) {
-        switch (op->words[1]) {
+        break;
+
+    case handler_ldh:
+        switch (op->dst) {
         case keyword_a:
             dst8 = &reg.br.a;
             break;
@@ -1641,15 +2781,16 @@ eval(u8 *code, int echo)
         case keyword_deref_u8:
             d8 = *(code+1);
             addr = 0xff00 + d8;
-            dst8 = peek8ptr(addr);
+            dst8 = &mem8;
+            write = true;
             break;
 
         default:
-            Keyword_repr(op->words[1]);
+            Keyword_repr(op->dst);
             die("other");
         }
 
-        switch (op->words[2]) {
+        switch (op->src) {
         case keyword_a:
             *dst8 = reg.br.a;
             break;
@@ -1663,13 +2804,16 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Keyword_repr(op->words[2]);
+            Keyword_repr(op->src);
             die("other");
         }
 
-    } else if ((op->words[0] == keyword_inc) ||  (op->words[0] == keyword_dec )) {
-        int step = (op->words[0] == keyword_inc) ? 1 : -1;
-        switch (op->words[1]) {
+        break;
+
+    case handler_inc:
+    case handler_dec:
+        step = (op->handler == handler_inc) ? 1 : -1;
+        switch (op->dst) {
         case keyword_a:
             reg.br.a += step;
             break;
@@ -1707,12 +2851,17 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Opcode_repr(op);
+            Opcode_repr(&opcode_table[*code]);
             die("default");
         }
 
-    } else if (op->words[0] == keyword_jp || op->words[0] == keyword_jr) {
-        if (op->words[0] == keyword_jp) {
+        break;
+
+    case handler_jp:
+    case handler_jr:
+        if (op->dst == keyword_hl) {
+            addr = reg.wr.hl;
+        } else if (op->handler == handler_jp) {
             addr  = *(code+1) << 0;
             addr += *(code+2) << 8;
         } else {
@@ -1721,60 +2870,78 @@ eval(u8 *code, int echo)
         }
         /*debug_var("x", addr);*/
         /*debug_var("d", op->num_operands);*/
-        if (op->num_operands == 2) {
-            int z = flag_z(reg.br.f);
-            int nz = !z;
-            /*debug_var("x", reg.br.f);*/
-            /*debug_var("x", flag_mask_z);*/
-            switch (op->words[1]) {
-            case keyword_z:
-                if (z)
-                    reg.wr.pc = addr;
-                else
-                    reg.wr.pc += op->bytes;
-                break;
+        if (op->src != keyword_nil && !condition_met(op->dst)) {
+            reg.wr.pc += op->bytes;
+            cycles = op->cycles_alt;
+        } else {
+            reg.wr.pc = addr;
+        }
 
-            case keyword_nz:
-                if (nz)
-                    reg.wr.pc = addr;
-                else
-                    reg.wr.pc += op->bytes;
-                break;
+        break;
 
-            default:
-                Keyword_repr(op->words[1]);
-                die("other");
-            }
+    case handler_call:
+        addr  = *(code+1) << 0;
+        addr += *(code+2) << 8;
+        if (op->src != keyword_nil && !condition_met(op->dst)) {
+            reg.wr.pc += op->bytes;
+            cycles = op->cycles_alt;
         } else {
+            push16(reg.wr.pc + op->bytes);
             reg.wr.pc = addr;
         }
+        break;
 
-    } else if (op->words[0] == keyword_add) {
-        switch (op->words[1]) {
+    case handler_rst:
+        push16(reg.wr.pc + op->bytes);
+        reg.wr.pc = *code & 0x38;
+        break;
+
+    case handler_ret:
+        if (op->dst != keyword_nil && !condition_met(op->dst)) {
+            reg.wr.pc += op->bytes;
+            cycles = op->cycles_alt;
+        } else {
+            reg.wr.pc = pop16();
+        }
+        break;
+
+    case handler_reti:
+        reg.wr.pc = pop16();
+        cpu.ei = true;
+        break;
+
+    case handler_halt:
+        cpu.halted = true;
+        break;
+
+    case handler_add:
+        switch (op->dst) {
         case keyword_hl:
             dst16 = &reg.wr.hl;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("other");
         }
 
-        switch (op->words[2]) {
+        switch (op->src) {
         case keyword_bc:
             *dst16 = reg.wr.bc;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[2]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->src);
             die("other");
         }
 
-    } else if (op->words[0] == keyword_sub) {
+        break;
+
+    case handler_sub:
         /*ere;*/
-        switch (op->words[1]) {
+        switch (op->dst) {
         case keyword_b:
             if (reg.br.a < reg.br.b)
                 reg.br.f = 1;
@@ -1784,15 +2951,17 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("other");
         }
 
-    } else if (op->words[0] == keyword_xor) {
+        break;
+
+    case handler_xor:
         /*ere;*/
         /*Opcode_repr(op);*/
-        switch (op->words[1]) {
+        switch (op->dst) {
         case keyword_a:
             reg.br.a ^= reg.br.a;
             break;
@@ -1803,67 +2972,86 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("other");
         }
 
-    } else if (op->words[0] == keyword_ldi || op->words[0] == keyword_ldd) {
-        int step = op->words[0] == keyword_ldi ? 1 : -1;
+        break;
 
-        switch (op->words[1]) {
+    case handler_ldi:
+    case handler_ldd:
+        step = op->handler == handler_ldi ? 1 : -1;
+
+        switch (op->dst) {
         case keyword_deref_hl:
             addr = reg.wr.hl;
-            dst8 = peek8ptr(addr);
+            dst8 = &mem8;
+            write = true;
             reg.wr.hl += step;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("unknown keyword");
         }
 
-        switch (op->words[2]) {
+        switch (op->src) {
         case keyword_a:
             *dst8 = reg.br.a;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[2]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->src);
             die("unknown keyword");
         }
 
-    } else if (op->words[0] == keyword_di) {
+        break;
+
+    case handler_di:
         cpu.ei = false;
+        break;
 
-    } else if (op->words[0] == keyword_ei) {
+    case handler_ei:
         cpu.ei = true;
+        break;
 
-    } else if (op->words[0] == keyword_cp) {
-        switch (op->words[1]) {
+    case handler_cp:
+        switch (op->dst) {
         case keyword_u8:
             d8 = *(code+1);
             cp_result = reg.br.a - d8;
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[2]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->src);
             die("unknown keyword");
         }
 
         /*die("cp");*/
 
-    } else {
-        Opcode_repr(op);
+        break;
+
+    case handler_prefix:
+        cb_kernels[*(code+1)]();
+        op = &cb_opcode_info[*(code+1)];
+        cycles = op->cycles;
+        break;
+
+    default:
+        Opcode_repr(&opcode_table[*code]);
         die("unknown opcode");
     }
 
-    if (op->flags.z == 'z') {
+    if (write)
+        poke8(addr, mem8);
+
+    if (op->flags_calc & flag_mask_z) {
         int z;
-        switch (op->words[1]) {
+        switch (op->dst) {
         case keyword_a:
             z = !reg.br.a;
             break;
@@ -1901,72 +3089,4444 @@ eval(u8 *code, int echo)
             break;
 
         default:
-            Opcode_repr(op);
-            Keyword_repr(op->words[1]);
+            Opcode_repr(&opcode_table[*code]);
+            Keyword_repr(op->dst);
             die("other");
         }
 
-        if (z)
-            reg.br.f |= flag_mask_z;
-        else
-            reg.br.f &= ~flag_mask_z;
+        if (z)
+            reg.br.f |= flag_mask_z;
+        else
+            reg.br.f &= ~flag_mask_z;
+    }
+
+    if (op->flags_fixed) {
+        reg.br.f &= ~(op->flags_fixed & 0xf0);
+        reg.br.f |= (op->flags_fixed & 0x0f) << 4;
+    }
+
+
+    switch (op->handler) {
+    case handler_jp:
+    case handler_jr:
+    case handler_call:
+    case handler_ret:
+    case handler_reti:
+    case handler_rst:
+        break;
+    default:
+        reg.wr.pc += op->bytes;
+    }
+
+    cpu.cycles += cycles;
+}
+
+
+void
+map_init(void)
+{
+    for (int i = 0; i < 0x100; i += 1) {
+        map.page[i] = memory + i * 0x100;
+        map.attr[i] = 0;
+    }
+    for (int i = 0; i < 0x80; i += 1)
+        map.rom_offset[i] = i * 0x100;
+    for (int i = 0; i < NUM_TILES * 16 / 0x100; i += 1)
+        map.attr[0x80 + i] = page_write_hook;
+    map.attr[0xff] = page_write_hook | page_read_hook;
+
+    memset(tiles.dirty, true, sizeof tiles.dirty);
+}
+
+
+void
+write_hook(u16 addr, u8 v)
+{
+    if (map.attr[addr >> 8] & page_write_count)
+        heat.count[heat_write][heat_page(addr)] += 1;
+
+    if (map.attr[addr >> 8] & page_write_watch)
+        debug_watch(addr, watch_write);
+
+    if (!(map.attr[addr >> 8] & page_write_hook))
+        map.page[addr >> 8][addr & 0xff] = v;
+    else if (addr < 0x8000)
+        mbc_write(addr, v);
+    else if (addr < 0xa000)
+        vram_write(addr, v);
+    else if (addr < 0xc000)
+        return;     /* cart ram is disabled */
+    else
+        io_write(addr, v);
+}
+
+
+u8
+read_hook(u16 addr)
+{
+    if (map.attr[addr >> 8] & page_read_count)
+        heat.count[heat_read][heat_page(addr)] += 1;
+
+    if (map.attr[addr >> 8] & page_read_watch)
+        debug_watch(addr, watch_read);
+
+    if (addr < 0xff00)
+        return *peek8ptr(addr);
+
+    return io_read(addr);
+}
+
+
+u8
+io_peek(u16 addr)
+{
+    /* what io_read would return, without syncing or counting polls */
+    u8 v = memory[addr];
+    u64 ticks = 0;
+    u64 tima = 0;
+
+    switch (addr) {
+    case io_joyp:
+        v = 0xc0 | (v & 0x30) | 0x0f;
+        if (!(v & 0x10))
+            v &= ~(joy.buttons & 0x0f);
+        if (!(v & 0x20))
+            v &= ~(joy.buttons >> 4);
+        break;
+
+    case io_div:
+        v = (u8)((cpu.cycles - timer.div_base) >> 8);
+        break;
+
+    case io_tima:
+        /* timer_sync's count, past an overflow it goes round from tma */
+        if (memory[io_tac] & 0x04)
+            ticks = (cpu.cycles - timer.div_base) / timer_period()
+                  - (timer.base - timer.div_base) / timer_period();
+        tima = timer.tima + ticks;
+        if (tima > 0xff)
+            tima = memory[io_tma] + (tima - 0x100) % (0x100 - memory[io_tma]);
+        v = (u8)tima;
+        break;
+    }
+    return v;
+}
+
+
+u8
+io_read(u16 addr)
+{
+    switch (addr) {
+    case io_joyp:
+        memory[addr] = 0xc0 | (memory[addr] & 0x30) | 0x0f;
+        if (!(memory[addr] & 0x10))
+            memory[addr] &= ~(joy.buttons & 0x0f);
+        if (!(memory[addr] & 0x20))
+            memory[addr] &= ~(joy.buttons >> 4);
+        break;
+
+    case io_div:
+        cpu.polls += 1;
+        memory[addr] = (u8)((cpu.cycles - timer.div_base) >> 8);
+        break;
+
+    case io_tima:
+        cpu.polls += 1;
+        timer_sync();
+        memory[addr] = (u8)timer.tima;
+        break;
+
+    case io_nr52:
+        /* channels end on their own as lengths run out */
+        cpu.polls += 1;
+        apu_run_to(cpu.cycles);
+        break;
+    }
+    return memory[addr];
+}
+
+
+u8 *
+rom_page(u32 offset)
+{
+    if (cheats.shadow && cheats.shadow[offset >> 8])
+        return cheats.shadow[offset >> 8];
+    return rom + offset;
+}
+
+
+void
+map_rom(void)
+{
+    for (int i = 0; i < 0x40; i += 1) {
+        map.page[i] = rom_page(i * 0x100);
+        map.rom_offset[i] = i * 0x100;
+    }
+    map_rom_bank(cart.rom_bank);
+}
+
+
+void
+map_rom_bank(int bank)
+{
+    bank %= cart.num_rom_banks;
+    cart.rom_bank = bank;
+    for (int i = 0; i < 0x40; i += 1) {
+        /* shadow pages for cheats aren't in the rom, so keep the offset too */
+        map.rom_offset[0x40 + i] = bank * 0x4000 + i * 0x100;
+        map.page[0x40 + i] = rom_page(map.rom_offset[0x40 + i]);
+    }
+}
+
+
+int
+hex_digits(u8 *out, const char *s, int n)
+{
+    /* n hex digits, dashes are skipped, returns how many were found */
+    int i = 0;
+
+    for (; *s && !isspace(*s); s += 1) {
+        if (*s == '-')
+            continue;
+        if (!isxdigit(*s) || i == n)
+            return -1;
+        out[i++] = isdigit(*s) ? *s - '0' : (tolower(*s) - 'a' + 10);
+    }
+    return i;
+}
+
+
+int
+cheat_add(const char *code)
+{
+    u8 d[9];
+    int n = hex_digits(d, code, 9);
+    int dashes = strchr(code, '-') != NULL;
+
+    if (n == 8 && !dashes) {
+        /* gameshark ttvvllhh, the type byte only picks a cgb wram bank */
+        Freeze *f = &cheats.freezes[cheats.num_freezes];
+        u16 addr = (d[6] << 12) | (d[7] << 8) | (d[4] << 4) | d[5];
+
+        if (cheats.num_freezes == MAX_CHEATS) {
+            printf("too many freezes\n");
+            return 1;
+        }
+        if (addr < 0xa000 || (addr >= 0xe000 && addr < 0xff80)) {
+            printf("gameshark code %s isn't for ram\n", code);
+            return 1;
+        }
+        f->addr = addr;
+        f->value = (d[2] << 4) | d[3];
+        cheats.num_freezes += 1;
+        return 0;
+    }
+
+    if (n == 6 || n == 9) {
+        /* game genie abc-def-ghi: ab value, fcde ^ $f000 address, gi compare */
+        Patch *p = &cheats.patches[cheats.num_patches];
+        u16 addr = ((d[5] ^ 0xf) << 12) | (d[2] << 8) | (d[3] << 4) | d[4];
+
+        if (cheats.num_patches == MAX_CHEATS) {
+            printf("too many patches\n");
+            return 1;
+        }
+        if (addr >= 0x8000) {
+            printf("game genie code %s isn't for rom\n", code);
+            return 1;
+        }
+        if (!rom) {
+            printf("game genie codes need a rom\n");
+            return 1;
+        }
+        p->addr = addr;
+        p->value = (d[0] << 4) | d[1];
+        p->compare = -1;
+        if (n == 9) {
+            u8 c = (d[6] << 4) | d[8];
+            p->compare = (u8)((c >> 2) | (c << 6)) ^ 0xba;
+        }
+        cheats.num_patches += 1;
+        cheat_patch(p);
+        return 0;
+    }
+
+    printf("%s isn't a game genie or gameshark code\n", code);
+    return 1;
+}
+
+
+void
+cheat_patch(Patch *p)
+{
+    /* $4000 and up is patched in every bank that can be mapped there */
+    int first = p->addr < 0x4000 ? 0 : 1;
+    int last = p->addr < 0x4000 ? 1 : cart.num_rom_banks;
+
+    if (!cheats.shadow && !(cheats.shadow = calloc(rom_size >> 8, sizeof(u8 *))))
+        die("calloc shadow pages failed");
+
+    for (int bank = first; bank < last; bank += 1) {
+        u32 offset = bank * 0x4000 + (p->addr & 0x3fff);
+        u8 **page = &cheats.shadow[offset >> 8];
+
+        if (p->compare >= 0 && rom[offset] != p->compare)
+            continue;
+        if (!*page) {
+            if (!(*page = malloc(0x100)))
+                die("malloc shadow page failed");
+            memcpy(*page, rom + (offset & ~0xff), 0x100);
+        }
+        (*page)[offset & 0xff] = p->value;
+    }
+    map_rom();
+}
+
+
+void
+cheat_clear(void)
+{
+    if (cheats.shadow) {
+        for (u32 i = 0; i < rom_size >> 8; i += 1)
+            free(cheats.shadow[i]);
+        free(cheats.shadow);
+        cheats.shadow = NULL;
+        map_rom();
+    }
+    cheats.num_patches = 0;
+    cheats.num_freezes = 0;
+}
+
+
+void
+cheat_freeze(void)
+{
+    for (int i = 0; i < cheats.num_freezes; i += 1) {
+        Freeze *f = &cheats.freezes[i];
+        /* disabled cart ram pages all share cart_off */
+        if (f->addr >= 0xa000 && f->addr < 0xc000 && cart.ram_size && !cart.ram_on)
+            continue;
+        map.page[f->addr >> 8][f->addr & 0xff] = f->value;
+        map.dirty[f->addr >> 8] = true;
+    }
+}
+
+
+void
+mbc_write(u16 addr, u8 v)
+{
+    int bank = cart.rom_bank;
+    int ram_bank = cart.ram_bank;
+    int ram_on = cart.ram_on;
+
+    if (addr < 0x2000)
+        ram_on = (v & 0x0f) == 0x0a;
+
+    switch (cart.mbc) {
+    case 1:
+        /* $4000 gets bank2 as bits 5-6 above the low five, which skip 0 */
+        if (0x2000 <= addr && addr < 0x4000)
+            bank = (v & 0x1f) ? (v & 0x1f) : 1;
+        else if (0x4000 <= addr && addr < 0x6000)
+            cart.bank2 = v & 3;
+        else if (0x6000 <= addr)
+            cart.mode = v & 1;
+        bank = (cart.bank2 << 5) | (bank & 0x1f);
+        ram_bank = cart.mode ? cart.bank2 : 0;
+        break;
+
+    case 3:
+        if (0x2000 <= addr && addr < 0x4000)
+            bank = (v & 0x7f) ? (v & 0x7f) : 1;
+        else if (0x4000 <= addr && addr < 0x6000 && v < 4)
+            ram_bank = v;   /* $08-$0c select the clock, which isn't here */
+        break;
+
+    case 5:
+        if (0x2000 <= addr && addr < 0x3000)
+            bank = (bank & 0x100) | v;
+        else if (0x3000 <= addr && addr < 0x4000)
+            bank = (bank & 0xff) | ((v & 1) << 8);
+        else if (0x4000 <= addr && addr < 0x6000)
+            ram_bank = v & 0x0f;
+        break;
+
+    default:
+        /* no mbc, writes to rom are dropped */
+        return;
+    }
+
+    if (bank != cart.rom_bank)
+        map_rom_bank(bank);
+
+    if (!cart.ram_size)
+        return;
+    if (cart.ram_on && !ram_on && cart.sav_shared)
+        sav_flush(false);
+    if (ram_on != cart.ram_on || ram_bank != cart.ram_bank) {
+        cart.ram_on = ram_on;
+        cart.ram_bank = ram_bank;
+        map_cart_ram();
+    }
+}
+
+
+void
+map_cart_ram(void)
+{
+    /* a disabled cart reads $ff and the write hook drops stores */
+    for (int i = 0; i < 0x20; i += 1) {
+        int p = 0xa0 + i;
+
+        map.dirty[p] = true;
+        if (!cart.ram_on) {
+            map.page[p] = cart_off;
+            map.attr[p] |= page_write_hook;
+            continue;
+        }
+        map.page[p] = cart.ram + (cart.ram_bank * 0x2000 + i * 0x100) % cart.ram_size;
+        map.attr[p] &= ~page_write_hook;
+    }
+}
+
+
+void
+sav_open(const char *path, int private)
+{
+    /*
+     * Shared maps the .sav straight into the cart ram pages. Private is
+     * copy on write, runs can share one base save and never change it.
+     */
+#if defined(_WIN32)
+    (void)path;
+    (void)private;
+    die("-sav needs mmap()");
+#else
+    struct stat st;
+    int fd = -1;
+    void *p = NULL;
+
+    if (!cart.ram_size)
+        die("this cart has no ram to save");
+    /* without a battery the ram is gone at power off, there is nothing to keep */
+    if (!cart.battery)
+        die("this cart's ram has no battery");
+    if ((fd = open(path, private ? O_RDONLY : O_RDWR | O_CREAT, 0644)) < 0)
+        die("open %s failed", path);
+    if (fstat(fd, &st))
+        die("stat %s failed", path);
+    if (st.st_size < cart.ram_size) {
+        if (private)
+            die("%s is smaller than the cart's %u bytes of ram", path, cart.ram_size);
+        if (ftruncate(fd, cart.ram_size))
+            die("growing %s failed", path);
+    }
+
+    p = mmap(NULL, cart.ram_size, PROT_READ | PROT_WRITE,
+             private ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        die("mmap %s failed", path);
+    close(fd);
+
+    free(cart.ram);
+    cart.ram = p;
+    cart.sav_shared = !private;
+    map_cart_ram();
+    atexit(sav_close);
+#endif
+}
+
+
+void
+sav_flush(int wait)
+{
+#if !defined(_WIN32)
+    if (msync(cart.ram, cart.ram_size, wait ? MS_SYNC : MS_ASYNC))
+        die("msync failed");
+#else
+    (void)wait;
+#endif
+}
+
+
+void
+sav_close(void)
+{
+    if (cart.sav_shared)
+        sav_flush(true);
+}
+
+
+void
+vram_write(u16 addr, u8 v)
+{
+    memory[addr] = v;
+    if (addr < 0x8000 + NUM_TILES * 16)
+        tiles.dirty[(addr - 0x8000) / 16] = true;
+}
+
+
+void
+io_write(u16 addr, u8 v)
+{
+    u8 old = memory[addr];
+
+    if (0xff10 <= addr && addr < 0xff40) {
+        apu_write(addr, v);
+        return;
+    }
+
+    switch (addr) {
+    case io_lcdc:
+        memory[addr] = v;
+        if ((v ^ old) & lcdc_on) {
+            /* the lcd restarts from the top of a frame */
+            ppu.ly = 0;
+            ppu.window_line = 0;
+            memory[io_ly] = 0;
+            if (!(v & lcdc_on))
+                memset(ppu.frame, 0, sizeof ppu.frame);
+            ppu_mode(v & lcdc_on ? 2 : 0);
+            schedule(event_ppu, cpu.cycles + (v & lcdc_on ? 80 : CYCLES_PER_LINE));
+        }
+        break;
+
+    case io_stat:
+        memory[addr] = (old & 0x87) | (v & 0x78);
+        break;
+
+    case io_ly:
+        /* read only */
+        break;
+
+    case io_div:
+    case io_tima:
+    case io_tma:
+    case io_tac:
+        timer_sync();
+        memory[addr] = v;
+        if (addr == io_div)
+            timer.div_base = cpu.cycles;
+        if (addr == io_tima)
+            timer.tima = v;
+        timer_schedule();
+        break;
+
+    case io_dma:
+        memory[addr] = v;
+        oam_dma(v);
+        break;
+
+    case io_sc:
+        if (cable.on) {
+            /* the peer may still ask what SC was before now */
+            cable.sc_before[cable.cur] = memory[addr];
+            cable.sc_at[cable.cur] = cpu.cycles;
+            cable.stop = true;
+        }
+        memory[addr] = v;
+        /* only the internal clock drives a transfer, a slave waits on its peer */
+        if ((v & 0x81) == 0x81)
+            schedule(event_serial, cpu.cycles + SERIAL_CYCLES);
+        break;
+
+    case io_joyp:
+        memory[addr] = (old & 0xcf) | (v & 0x30);
+        break;
+
+    default:
+        memory[addr] = v;
+        break;
+    }
+}
+
+
+void
+oam_dma(u8 page)
+{
+    /*
+     * done in one go at the write. the 160 cycles where the cpu can only
+     * reach hram aren't modelled, code waits them out from hram anyway.
+     */
+    if (page >= 0xfe)
+        page -= 0x20;
+    memcpy(memory + 0xfe00, map.page[page], 0xa0);
+    map.dirty[0xfe] = true;
+}
+
+
+int
+timer_period(void)
+{
+    static const int period[4] = {1024, 16, 64, 256};
+    return period[memory[io_tac] & 3];
+}
+
+
+void
+timer_sync(void)
+{
+    /* tima counts falling edges of a bit of the divider since the last sync */
+    u64 now = cpu.cycles - timer.div_base;
+    u64 then = timer.base - timer.div_base;
+    int period = timer_period();
+    u64 ticks = 0;
+
+    if (memory[io_tac] & 0x04)
+        ticks = now / period - then / period;
+    timer.base = cpu.cycles;
+
+    while (ticks) {
+        u64 left = 0x100 - timer.tima;
+        if (ticks < left) {
+            timer.tima += (int)ticks;
+            break;
+        }
+        ticks -= left;
+        timer.tima = memory[io_tma];
+        memory[io_if] |= int_mask_timer;
+    }
+}
+
+
+void
+timer_schedule(void)
+{
+    u64 count = cpu.cycles - timer.div_base;
+    int period = timer_period();
+
+    if (!(memory[io_tac] & 0x04)) {
+        schedule(event_timer, (u64)-1);
+        return;
+    }
+    count = (count / period + 0x100 - timer.tima) * period;
+    schedule(event_timer, timer.div_base + count);
+}
+
+
+void
+schedule(Event e, u64 at)
+{
+    sched.at[e] = at;
+    sched.next = (u64)-1;
+    for (int i = 0; i < event_end; i += 1) {
+        if (sched.at[i] < sched.next)
+            sched.next = sched.at[i];
+    }
+}
+
+
+void
+run_events(void)
+{
+    while (cpu.cycles >= sched.next) {
+        for (int i = 0; i < event_end; i += 1) {
+            if (sched.at[i] != sched.next)
+                continue;
+
+            switch (i) {
+            case event_ppu:
+                ppu_event();
+                break;
+
+            case event_timer:
+                timer_sync();
+                timer_schedule();
+                break;
+
+            case event_debug:
+                schedule(event_debug, (u64)-1);
+                debug_repl();
+                break;
+
+            case event_serial:
+                serial_event();
+                break;
+
+            case event_link:
+                schedule(event_link, (u64)-1);
+                cable.stop = true;
+                break;
+
+            default:
+                die("unknown event %d", i);
+            }
+            break;
+        }
+    }
+}
+
+
+void
+interrupts(void)
+{
+    u8 pending = memory[0xff0f] & memory[0xffff] & 0x1f;
+    int i = 0;
+
+    if (!pending)
+        return;
+
+    /* any enabled interrupt ends a halt, even with ime off */
+    cpu.halted = false;
+
+    if (!cpu.ei)
+        return;
+
+    for (i = 0; !(pending & (1 << i)); i += 1)
+        ;
+
+    memory[0xff0f] &= ~(1 << i);
+    cpu.ei = false;
+    push16(reg.wr.pc);
+    reg.wr.pc = 0x40 + 8 * i;
+    hook(interrupt, i);
+    cpu.cycles += 20;
+}
+
+
+void
+idle_check(void)
+{
+    /*
+     * Called on every backwards branch. If the loop came round to the same
+     * pc with identical registers and no writes in between, every iteration
+     * reads the same values until an event changes hardware state, so the
+     * whole iterations before the next event can be skipped.
+     */
+    u64 period = cpu.cycles - idle.cycles;
+    u64 n = 0;
+
+    if (reg.wr.pc == idle.pc
+            && cpu.writes == idle.writes
+            && cpu.polls == idle.polls
+            && cpu.ei == idle.ei
+            && period && period <= 256
+            && sched.next > cpu.cycles
+            && !memcmp(&reg, &idle.reg, sizeof reg)) {
+        n = (sched.next - cpu.cycles) / period;
+        cpu.cycles += n * period;
+    }
+
+    idle.pc = reg.wr.pc;
+    idle.cycles = cpu.cycles;
+    idle.writes = cpu.writes;
+    idle.polls = cpu.polls;
+    idle.ei = cpu.ei;
+    memcpy(&idle.reg, &reg, sizeof reg);
+}
+
+
+void
+step(int echo)
+{
+    u8 code[3] = {0};
+    u16 pc = reg.wr.pc;
+
+    if (cpu.halted) {
+        /* only an interrupt can end a halt, and they come from events */
+        if (sched.next > cpu.cycles)
+            cpu.cycles = global.no_fast_forward ? cpu.cycles + 4 : sched.next;
+    } else {
+        if (map.attr[pc >> 8] & page_break)
+            debug_break(pc);
+
+        /* fetches don't go through the read hooks */
+        code[0] = *peek8ptr(reg.wr.pc + 0);
+        code[1] = *peek8ptr(reg.wr.pc + 1);
+        code[2] = *peek8ptr(reg.wr.pc + 2);
+
+        hook(instruction, pc, code);
+        eval(code, echo);
+
+        if (reg.wr.pc < pc && !global.no_fast_forward)
+            idle_check();
+    }
+
+    if (cpu.cycles >= sched.next)
+        run_events();
+
+    interrupts();
+
+    if (global.step_extras)
+        step_extras(pc, code);
+}
+
+
+int
+cond_compile(Cond *c, const char *x)
+{
+    /* same words as eval_rpn: numbers, registers, *r16 and *addr */
+    static const struct {
+        const char *name;
+        Cond_Op op;
+        u16 offset;
+    } regs[] = {
+        {"a",  cond_r8,  offsetof(union registers, br.a)},
+        {"f",  cond_r8,  offsetof(union registers, br.f)},
+        {"b",  cond_r8,  offsetof(union registers, br.b)},
+        {"c",  cond_r8,  offsetof(union registers, br.c)},
+        {"d",  cond_r8,  offsetof(union registers, br.d)},
+        {"e",  cond_r8,  offsetof(union registers, br.e)},
+        {"h",  cond_r8,  offsetof(union registers, br.h)},
+        {"l",  cond_r8,  offsetof(union registers, br.l)},
+        {"af", cond_r16, offsetof(union registers, wr.af)},
+        {"bc", cond_r16, offsetof(union registers, wr.bc)},
+        {"de", cond_r16, offsetof(union registers, wr.de)},
+        {"hl", cond_r16, offsetof(union registers, wr.hl)},
+        {"sp", cond_r16, offsetof(union registers, wr.sp)},
+        {"pc", cond_r16, offsetof(union registers, wr.pc)},
+    };
+    static const char *syms[] = {
+#define X(name, sym) sym,
+        LIST_OF_COND_OPS
+#undef X
+    };
+    char tok[64] = "";
+    const char *in = x;
+    int depth = 0;
+    size_t i = 0;
+
+    c->len = 0;
+    while (*in != '\n' && *in != '\0') {
+        Cond_Insn *insn = &c->code[c->len];
+        const char *w = tok;
+        int deref = false;
+        i32 n = 0;
+
+        in += read_token(tok, in, sizeof tok);
+        chomp((char **)&in, ' ');
+
+        if (c->len == COND_LEN - 1) {
+            printf("condition too long\n");
+            return 1;
+        }
+
+        for (i = cond_add; i < cond_end; i += 1) {
+            if (str_eq(syms[i], tok))
+                break;
+        }
+        if (i < cond_end) {
+            if (depth < 2) {
+                printf("%s needs two values\n", tok);
+                return 1;
+            }
+            insn->op = i;
+            depth -= 1;
+            c->len += 1;
+            continue;
+        }
+
+        if (*w == '*') {
+            deref = true;
+            w += 1;
+        }
+
+        if (!parse_number(&n, w)) {
+            insn->op = deref ? cond_peek : cond_push;
+            insn->arg = (u16)n;
+        } else {
+            for (i = 0; i < sizeof regs / sizeof regs[0]; i += 1) {
+                if (str_eq(regs[i].name, w))
+                    break;
+            }
+            if (i == sizeof regs / sizeof regs[0] || (deref && regs[i].op != cond_r16)) {
+                printf("unknown word in condition: %s\n", tok);
+                return 1;
+            }
+            insn->op = deref ? cond_deref_r16 : regs[i].op;
+            insn->arg = regs[i].offset;
+        }
+
+        if (++depth > COND_STACK) {
+            printf("condition too deep\n");
+            return 1;
+        }
+        c->len += 1;
+    }
+
+    if (c->len && depth != 1) {
+        printf("condition should leave one value\n");
+        return 1;
+    }
+    c->code[c->len].op = cond_end;
+    return 0;
+}
+
+
+static u8
+cond_read(u16 addr)
+{
+    /* straight at the page, so a condition can't set off a watch */
+    return addr >= 0xff00 ? io_peek(addr) : *peek8ptr(addr);
+}
+
+
+i32
+cond_eval(Cond *c)
+{
+    i32 stack[COND_STACK];
+    i32 *sp = stack;
+    u8 *r = (u8 *)&reg;
+    Cond_Insn *insn = c->code;
+
+    if (!c->len)
+        return true;
+
+#define binary(expr) \
+    do { \
+        sp[-2] = (expr); \
+        sp -= 1; \
+    } while (0)
+
+    for (;; insn += 1) {
+        switch (insn->op) {
+        case cond_push:      *sp++ = insn->arg; break;
+        case cond_r8:        *sp++ = r[insn->arg]; break;
+        case cond_r16:       *sp++ = *(u16 *)(r + insn->arg); break;
+        case cond_peek:      *sp++ = cond_read(insn->arg); break;
+        case cond_deref_r16: *sp++ = cond_read(*(u16 *)(r + insn->arg)); break;
+        case cond_add:       binary(sp[-2] + sp[-1]); break;
+        case cond_sub:       binary(sp[-2] - sp[-1]); break;
+        case cond_and:       binary(sp[-2] & sp[-1]); break;
+        case cond_or:        binary(sp[-2] | sp[-1]); break;
+        case cond_eq:        binary(sp[-2] == sp[-1]); break;
+        case cond_ne:        binary(sp[-2] != sp[-1]); break;
+        case cond_lt:        binary(sp[-2] < sp[-1]); break;
+        case cond_gt:        binary(sp[-2] > sp[-1]); break;
+        case cond_le:        binary(sp[-2] <= sp[-1]); break;
+        case cond_ge:        binary(sp[-2] >= sp[-1]); break;
+        default:             return sp[-1];
+        }
+    }
+#undef binary
+}
+
+
+u64
+mono_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER t;
+    LARGE_INTEGER hz;
+    QueryPerformanceCounter(&t);
+    QueryPerformanceFrequency(&hz);
+    return (u64)((double)t.QuadPart * 1e9 / hz.QuadPart);
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (u64)t.tv_sec * 1000000000ull + t.tv_nsec;
+#endif
+}
+
+
+u64
+ticks(void)
+{
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return mono_ns();
+#endif
+}
+
+
+int
+hist_bucket(u64 v)
+{
+    int e = 0;
+
+    if (v < HIST_SUB)
+        return (int)v;
+    while ((v >> e) >= 2 * HIST_SUB)
+        e += 1;
+    return (e + 1) * HIST_SUB + (int)((v >> e) - HIST_SUB);
+}
+
+
+u64
+hist_value(int b)
+{
+    /* the low end of a bucket */
+    if (b < HIST_SUB)
+        return b;
+    return (u64)(HIST_SUB + b % HIST_SUB) << (b / HIST_SUB - 1);
+}
+
+
+void
+latency_add(Stage s, u64 dt)
+{
+    latency.count[s][hist_bucket(dt)] += 1;
+    latency.n[s] += 1;
+    if (dt > latency.max[s])
+        latency.max[s] = dt;
+}
+
+
+u64
+latency_percentile(Stage s, double p)
+{
+    u64 want = (u64)(latency.n[s] * p + 0.999999);
+    u64 seen = 0;
+
+    for (int b = 0; b < HIST_BUCKETS; b += 1) {
+        seen += latency.count[s][b];
+        if (seen >= want && seen)
+            return hist_value(b);
+    }
+    return latency.max[s];
+}
+
+
+void
+latency_dump(void)
+{
+    /* ticks to ns from the time since startup, no calibration loop */
+    double ns_per_tick = 1;
+
+#if HAVE_TSC
+    u64 dt = ticks() - latency.tick0;
+    if (dt)
+        ns_per_tick = (double)(mono_ns() - latency.ns0) / dt;
+#endif
+
+    fprintf(stderr, "\n%-14s %8s %10s %10s %10s\n", "stage", "count", "p50 ns", "p99 ns", "max ns");
+    for (int s = 0; s < stage_end; s += 1) {
+        if (!latency.n[s])
+            continue;
+        fprintf(stderr, "%-14s %8llu %10.0f %10.0f %10.0f\n",
+                stage_names[s], latency.n[s],
+                latency_percentile(s, 0.50) * ns_per_tick,
+                latency_percentile(s, 0.99) * ns_per_tick,
+                latency.max[s] * ns_per_tick);
+    }
+}
+
+
+void
+debug_map(void)
+{
+    int i = 0;
+    int p = 0;
+
+    for (p = 0; p < 0x100; p += 1)
+        map.attr[p] &= ~(page_break | page_read_watch | page_write_watch);
+
+    for (i = 0; i < debug.num_breaks; i += 1)
+        map.attr[debug.breaks[i].addr >> 8] |= page_break;
+
+    for (i = 0; i < debug.num_watches; i += 1) {
+        Watchpoint *w = &debug.watches[i];
+        for (p = w->lo >> 8; p <= w->hi >> 8; p += 1) {
+            if (w->kind & watch_read)
+                map.attr[p] |= page_read_watch;
+            if (w->kind & watch_write)
+                map.attr[p] |= page_write_watch;
+        }
+    }
+}
+
+
+void
+debug_break(u16 pc)
+{
+    for (int i = 0; i < debug.num_breaks; i += 1) {
+        if (debug.breaks[i].addr != pc || !cond_eval(&debug.breaks[i].cond))
+            continue;
+        printf(RESET "\nbreak at $%04x\n", pc);
+        debug_repl();
+        return;
+    }
+}
+
+
+void
+debug_watch(u16 addr, int kind)
+{
+    for (int i = 0; i < debug.num_watches; i += 1) {
+        Watchpoint *w = &debug.watches[i];
+        if (!(w->kind & kind) || addr < w->lo || w->hi < addr || !cond_eval(&w->cond))
+            continue;
+        /* the access finishes, the repl runs once the instruction is done */
+        printf(RESET "\n%s $%04x at $%04x\n",
+                kind == watch_read ? "read" : "write", addr, reg.wr.pc);
+        schedule(event_debug, cpu.cycles);
+        return;
+    }
+}
+
+
+void
+debug_repl(void)
+{
+    char line_buf[512] = "";
+
+    debug.paused = true;
+    while (debug.paused) {
+        print_line_prefix();
+        if (fgets(line_buf, sizeof line_buf, stdin) == NULL) {
+            /* nobody to answer, run on without the traps */
+            debug.num_breaks = 0;
+            debug.num_watches = 0;
+            debug_map();
+            debug.paused = false;
+            break;
+        }
+        eval_string(line_buf, false);
+    }
+    printf(RESET);
+}
+
+
+int
+debug_command(const char *word, char *args)
+{
+    static const struct {
+        const char *name;
+        void (*fn)(char *args);
+    } commands[] = {
+#define X(name) {#name, cmd_##name},
+        LIST_OF_COMMANDS
+#undef X
+    };
+
+    for (size_t i = 0; i < sizeof commands / sizeof commands[0]; i += 1) {
+        if (str_eq(commands[i].name, word)) {
+            commands[i].fn(args);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+void
+cmd_break(char *args)
+{
+    char word[64] = "";
+    i32 addr = 0;
+
+    args += read_token(word, args, sizeof word);
+    if (parse_number(&addr, word) || addr < 0 || addr > 0xffff) {
+        printf("break wants an address: %s\n", word);
+        return;
+    }
+    if (debug.num_breaks == MAX_BREAKS) {
+        printf("too many breakpoints\n");
+        return;
+    }
+    chomp(&args, ' ');
+    if (cond_compile(&debug.breaks[debug.num_breaks].cond, args))
+        return;
+    debug.breaks[debug.num_breaks].addr = addr;
+    debug.num_breaks += 1;
+    debug_map();
+}
+
+
+void
+cmd_watch(char *args)
+{
+    char word[64] = "";
+    i32 lo = 0;
+    i32 hi = 0;
+    Watchpoint *w = NULL;
+    char *cond = NULL;
+
+    args += read_token(word, args, sizeof word);
+    chomp(&args, ' ');
+    if (parse_number(&lo, word) || lo < 0 || lo > 0xffff) {
+        printf("watch wants an address: %s\n", word);
+        return;
+    }
+    hi = lo;
+
+    /* watch $lo [$hi] [r|w|rw] [condition], a condition can't start with a number */
+    cond = args;
+    args += read_token(word, args, sizeof word);
+    chomp(&args, ' ');
+    if (*word && !parse_number(&hi, word)) {
+        cond = args;
+        args += read_token(word, args, sizeof word);
+        chomp(&args, ' ');
+    }
+    if (str_eq(word, "r") || str_eq(word, "w") || str_eq(word, "rw"))
+        cond = args;
+    if (hi < lo || hi > 0xffff) {
+        printf("bad watch range\n");
+        return;
+    }
+    if (debug.num_watches == MAX_WATCHES) {
+        printf("too many watchpoints\n");
+        return;
+    }
+
+    w = &debug.watches[debug.num_watches];
+    if (cond_compile(&w->cond, cond))
+        return;
+    w->lo = lo;
+    w->hi = hi;
+    w->kind = str_eq(word, "r") ? watch_read
+            : str_eq(word, "w") ? watch_write
+            : watch_read | watch_write;
+    debug.num_watches += 1;
+    debug_map();
+}
+
+
+void
+cmd_print(char *args)
+{
+    Cond c;
+
+    if (!cond_compile(&c, args) && c.len)
+        printf("%d $%x\n", cond_eval(&c), cond_eval(&c));
+}
+
+
+void
+cmd_joy(char *args)
+{
+    char word[64] = "";
+    i32 v = 0;
+
+    args += read_token(word, args, sizeof word);
+    if (parse_number(&v, word) || v < 0 || v > 0xff) {
+        printf("joy wants a byte of buttons\n");
+        return;
+    }
+    joy.pending = v;
+    joy.has_pending = true;
+}
+
+
+void
+cmd_stats(char *args)
+{
+    (void)args;
+    latency_dump();
+}
+
+
+u16
+search_addr(int i)
+{
+    return i < SEARCH_LOW ? 0xa000 + i : 0xff80 + (i - SEARCH_LOW);
+}
+
+
+void
+search_read(u8 *out)
+{
+    /* whole pages through the map, nothing here can touch io */
+    for (int i = 0; i < SEARCH_LOW; i += 0x100)
+        memcpy(out + i, map.page[(0xa000 + i) >> 8], 0x100);
+    memcpy(out + SEARCH_LOW, map.page[0xff] + 0x80, 0x80);
+}
+
+
+u32
+search_mask(Search_Op op, u8 *cur, u8 *old, u8 lo, u8 hi, int any)
+{
+    /* bit n set when byte n still matches */
+#if defined(__SSE2__)
+    __m128i c = _mm_loadu_si128((__m128i *)cur);
+    __m128i o = _mm_loadu_si128((__m128i *)old);
+    __m128i m;
+
+    switch (op) {
+    case search_eq:
+        m = _mm_cmpeq_epi8(c, _mm_set1_epi8(lo));
+        break;
+    case search_same:
+        m = _mm_cmpeq_epi8(c, o);
+        break;
+    case search_changed:
+        m = _mm_xor_si128(_mm_cmpeq_epi8(c, o), _mm_set1_epi8(-1));
+        break;
+    case search_up:
+    case search_down:
+        if (any) {
+            /* unsigned compare, max(c, o) is c and they differ */
+            __m128i big = op == search_up ? c : o;
+            m = _mm_cmpeq_epi8(_mm_max_epu8(c, o), big);
+            m = _mm_andnot_si128(_mm_cmpeq_epi8(c, o), m);
+        } else if (op == search_up) {
+            m = _mm_cmpeq_epi8(c, _mm_add_epi8(o, _mm_set1_epi8(lo)));
+        } else {
+            m = _mm_cmpeq_epi8(c, _mm_sub_epi8(o, _mm_set1_epi8(lo)));
+        }
+        break;
+    case search_word:
+        m = _mm_and_si128(
+                _mm_cmpeq_epi8(c, _mm_set1_epi8(lo)),
+                _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(cur + 1)), _mm_set1_epi8(hi)));
+        break;
+    default:
+        return 0xffff;
+    }
+    return _mm_movemask_epi8(m);
+#else
+    u32 mask = 0;
+
+    for (int i = 0; i < 16; i += 1) {
+        u8 c = cur[i];
+        u8 o = old[i];
+        int keep = true;
+
+        switch (op) {
+        case search_eq:      keep = c == lo; break;
+        case search_same:    keep = c == o; break;
+        case search_changed: keep = c != o; break;
+        case search_up:      keep = any ? c > o : c == (u8)(o + lo); break;
+        case search_down:    keep = any ? c < o : c == (u8)(o - lo); break;
+        case search_word:    keep = c == lo && cur[i + 1] == hi; break;
+        default:             break;
+        }
+        mask |= keep << i;
+    }
+    return mask;
+#endif
+}
+
+
+u64
+search_count(void)
+{
+    u64 n = 0;
+
+    for (int i = 0; i < SEARCH_BYTES / 64; i += 1) {
+#if defined(__GNUC__)
+        n += __builtin_popcountll(search.bits[i]);
+#else
+        for (u64 b = search.bits[i]; b; b &= b - 1)
+            n += 1;
+#endif
+    }
+    return n;
+}
+
+
+void
+search_show(int max)
+{
+    int shown = 0;
+
+    for (int i = 0; i < SEARCH_BYTES && shown < max; i += 1) {
+        if (search.bits[i / 64] >> (i % 64) & 1) {
+            printf("$%04x  %3d $%02x\n", search_addr(i), search.cur[i], search.cur[i]);
+            shown += 1;
+        }
+    }
+}
+
+
+void
+cmd_search(char *args)
+{
+    char word[64] = "";
+    Search_Op op = search_end;
+    i32 v = 0;
+    int any = true;
+    u64 n = 0;
+
+    args += read_token(word, args, sizeof word);
+    chomp(&args, ' ');
+    for (int i = 0; i < search_end; i += 1)
+        if (str_eq(word, search_op_names[i]))
+            op = i;
+    if (op == search_end) {
+        printf("search start, eq n, same, changed, up [n], down [n], word n or list\n");
+        return;
+    }
+
+    if (*args && *args != '\n') {
+        args += read_token(word, args, sizeof word);
+        if (parse_number(&v, word) || v < 0 || v > 0xffff) {
+            printf("search %s wants a number\n", search_op_names[op]);
+            return;
+        }
+        any = false;
+    } else if (op == search_eq || op == search_word) {
+        printf("search %s wants a number\n", search_op_names[op]);
+        return;
+    }
+
+    search_read(search.cur);
+
+    if (op == search_start || !search.started) {
+        memset(search.bits, 0xff, sizeof search.bits);
+        search.bits[SEARCH_BYTES / 64 - 1] &= ~(1ull << 63);    /* $ffff is ie */
+        search.started = true;
+    }
+
+    if (op == search_list) {
+        search_show(1 << 30);
+        return;
+    }
+
+    if (op != search_start) {
+        for (int i = 0; i < SEARCH_BYTES; i += 16) {
+            u64 *w = &search.bits[i / 64];
+            int shift = i % 64;
+
+            if (!(*w >> shift & 0xffff))
+                continue;
+            *w &= ~((u64)(~search_mask(op, search.cur + i, search.old + i, v, v >> 8, any) & 0xffff) << shift);
+        }
+        if (op == search_word) {
+            /* the high byte of the last address in a run isn't its neighbour */
+            search.bits[(SEARCH_LOW - 1) / 64] &= ~(1ull << ((SEARCH_LOW - 1) % 64));
+            search.bits[SEARCH_BYTES / 64 - 1] &= ~(3ull << 62);
+        }
+    }
+
+    memcpy(search.old, search.cur, SEARCH_BYTES);
+
+    n = search_count();
+    printf("%llu candidates\n", n);
+    if (n <= SEARCH_SHOW)
+        search_show(SEARCH_SHOW);
+}
+
+
+void
+cmd_cheat(char *args)
+{
+    char word[64] = "";
+
+    args += read_token(word, args, sizeof word);
+    if (str_eq(word, "clear")) {
+        cheat_clear();
+    } else if (word[0]) {
+        cheat_add(word);
+    } else {
+        for (int i = 0; i < cheats.num_patches; i += 1) {
+            Patch *p = &cheats.patches[i];
+            printf("patch  $%04x = $%02x", p->addr, p->value);
+            if (p->compare >= 0)
+                printf(" if $%02x", p->compare);
+            printf("\n");
+        }
+        for (int i = 0; i < cheats.num_freezes; i += 1)
+            printf("freeze $%04x = $%02x\n", cheats.freezes[i].addr, cheats.freezes[i].value);
+    }
+}
+
+
+void
+cmd_heat(char *args)
+{
+    /* the first one starts counting, later ones print what was counted */
+    (void)args;
+    if (!heat.on)
+        heat_open();
+    else
+        heat_table(stdout);
+}
+
+
+void
+cmd_delete(char *args)
+{
+    (void)args;
+    debug.num_breaks = 0;
+    debug.num_watches = 0;
+    debug_map();
+}
+
+
+void
+cmd_continue(char *args)
+{
+    (void)args;
+    debug.paused = false;
+}
+
+
+void
+ppu_mode(int mode)
+{
+    ppu.mode = mode;
+    memory[io_stat] = (memory[io_stat] & ~3) | mode;
+}
+
+
+void
+ppu_line(int ly)
+{
+    ppu.ly = ly;
+    memory[io_ly] = ly;
+
+    if (ly == memory[io_lyc]) {
+        memory[io_stat] |= stat_lyc_equal;
+        if (memory[io_stat] & stat_int_lyc)
+            memory[io_if] |= int_mask_stat;
+    } else {
+        memory[io_stat] &= ~stat_lyc_equal;
+    }
+}
+
+
+void
+ppu_event(void)
+{
+    /*
+     * Mode 2 (oam scan, 80 cycles), 3 (drawing, 172) and 0 (hblank, 204)
+     * for each visible line then ten lines of mode 1. A line is rendered in
+     * one go when it enters hblank.
+     */
+    u64 now = sched.at[event_ppu];
+    int lcd = memory[io_lcdc] & lcdc_on;
+    int ly = ppu.ly;
+
+    if (!lcd) {
+        /* keep frame timing so halts and frame counts still advance */
+        ly = (ly + 1) % LINES_PER_FRAME;
+        ppu.ly = ly;
+        if (ly == 0)
+            frame_done();
+        schedule(event_ppu, now + CYCLES_PER_LINE);
+        return;
+    }
+
+    switch (ppu.mode) {
+    case 2:
+        ppu_mode(3);
+        schedule(event_ppu, now + 172);
+        break;
+
+    case 3:
+        if (!global.no_render)
+            render_line(ly);
+        ppu_mode(0);
+        if (memory[io_stat] & stat_int_hblank)
+            memory[io_if] |= int_mask_stat;
+        schedule(event_ppu, now + 204);
+        break;
+
+    case 0:
+        ppu_line(ly + 1);
+        if (ppu.ly == SCREEN_H) {
+            ppu_mode(1);
+            frame_done();
+            ppu.window_line = 0;
+            memory[io_if] |= int_mask_vblank;
+            if (memory[io_stat] & stat_int_vblank)
+                memory[io_if] |= int_mask_stat;
+            schedule(event_ppu, now + CYCLES_PER_LINE);
+        } else {
+            ppu_mode(2);
+            if (memory[io_stat] & stat_int_oam)
+                memory[io_if] |= int_mask_stat;
+            schedule(event_ppu, now + 80);
+        }
+        break;
+
+    case 1:
+        if (ly + 1 == LINES_PER_FRAME) {
+            ppu_line(0);
+            ppu_mode(2);
+            if (memory[io_stat] & stat_int_oam)
+                memory[io_if] |= int_mask_stat;
+            schedule(event_ppu, now + 80);
+        } else {
+            ppu_line(ly + 1);
+            schedule(event_ppu, now + CYCLES_PER_LINE);
+        }
+        break;
+    }
+}
+
+
+void
+decode_tile_row(u8 lo, u8 hi, u8 *out)
+{
+    /* 2bpp planar row to 8 colour indices, leftmost pixel first */
+#if defined(__SSE2__)
+    const __m128i bits = _mm_setr_epi8(
+            0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+            0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i weight = _mm_setr_epi8(
+            1, 1, 1, 1, 1, 1, 1, 1,
+            2, 2, 2, 2, 2, 2, 2, 2);
+    __m128i v = _mm_unpacklo_epi64(_mm_set1_epi8(lo), _mm_set1_epi8(hi));
+
+    v = _mm_cmpeq_epi8(_mm_and_si128(v, bits), bits);
+    v = _mm_and_si128(v, weight);
+    v = _mm_or_si128(v, _mm_srli_si128(v, 8));
+    _mm_storel_epi64((__m128i *)out, v);
+#else
+    /* swar: broadcast each plane, keep bit 7-n in byte n, squash to 0/1 */
+#if SYSTEM_IS_BIG_ENDIAN
+    const u64 bits = 0x8040201008040201ull;
+#else
+    const u64 bits = 0x0102040810204080ull;
+#endif
+    const u64 ones = 0x0101010101010101ull;
+    u64 l = (lo * ones) & bits;
+    u64 h = (hi * ones) & bits;
+    u64 px = 0;
+
+    l = ((l + 0x7f7f7f7f7f7f7f7full) >> 7) & ones;
+    h = ((h + 0x7f7f7f7f7f7f7f7full) >> 7) & ones;
+    px = l | (h << 1);
+    memcpy(out, &px, 8);
+#endif
+}
+
+
+u8 *
+tile_row(int tile, int row, int flip)
+{
+    if (tiles.dirty[tile]) {
+        u8 *data = memory + 0x8000 + tile * 16;
+        for (int y = 0; y < 8; y += 1) {
+            decode_tile_row(data[y * 2], data[y * 2 + 1], tiles.px[tile][y]);
+            for (int x = 0; x < 8; x += 1)
+                tiles.flipped[tile][y][x] = tiles.px[tile][y][7 - x];
+        }
+        tiles.dirty[tile] = false;
+    }
+    return flip ? tiles.flipped[tile][row] : tiles.px[tile][row];
+}
+
+
+void
+render_tiles(u8 *out, u16 map_base, int y, int first_tile, u8 lcdc)
+{
+    /* 21 tiles of one map row, enough for any fine x scroll */
+    u8 *vram = memory + 0x8000;
+    int tile = 0;
+
+    for (int i = 0; i < 21; i += 1) {
+        tile = vram[map_base + (y / 8) * 32 + ((first_tile + i) & 31)];
+        if (!(lcdc & lcdc_tile_data))
+            tile = 256 + (i8)tile;
+        memcpy(out + i * 8, tile_row(tile, y & 7, false), 8);
+    }
+}
+
+
+void
+render_line(int ly)
+{
+    u8 lcdc = memory[io_lcdc];
+    u8 bgp = memory[io_bgp];
+    u8 *out = ppu.frame[ly];
+    u8 index[SCREEN_W];     /* bg/window colour indices, for sprite priority */
+    u8 line[21 * 8];
+    u8 *oam = memory + 0xfe00;
+    int x = 0;
+    int i = 0;
+
+    if (lcdc & lcdc_bg) {
+        u8 scx = memory[io_scx];
+        int y = (ly + memory[io_scy]) & 0xff;
+        render_tiles(line, lcdc & lcdc_bg_map ? 0x1c00 : 0x1800, y, scx / 8, lcdc);
+        memcpy(index, line + (scx & 7), SCREEN_W);
+    } else {
+        memset(index, 0, SCREEN_W);
+    }
+
+    if ((lcdc & lcdc_bg) && (lcdc & lcdc_window)
+            && ly >= memory[io_wy] && memory[io_wx] < SCREEN_W + 7) {
+        int wx = memory[io_wx] - 7;
+        render_tiles(line, lcdc & lcdc_window_map ? 0x1c00 : 0x1800, ppu.window_line, 0, lcdc);
+        for (x = wx < 0 ? 0 : wx; x < SCREEN_W; x += 1)
+            index[x] = line[x - wx];
+        ppu.window_line += 1;
+    }
+
+    for (x = 0; x < SCREEN_W; x += 1)
+        out[x] = (bgp >> (index[x] * 2)) & 3;
+
+    if (lcdc & lcdc_obj) {
+        int height = lcdc & lcdc_obj_size ? 16 : 8;
+        u8 *found[10];
+        int num_found = 0;
+
+        /* the first ten sprites on the line, in oam order */
+        for (i = 0; i < 40 && num_found < 10; i += 1) {
+            int top = oam[i * 4] - 16;
+            if (top <= ly && ly < top + height)
+                found[num_found++] = oam + i * 4;
+        }
+
+        /* lowest priority first: larger x, then later in oam */
+        for (i = 1; i < num_found; i += 1) {
+            u8 *o = found[i];
+            int j = i;
+            for (; j > 0 && found[j-1][1] <= o[1]; j -= 1)
+                found[j] = found[j-1];
+            found[j] = o;
+        }
+
+        for (i = 0; i < num_found; i += 1) {
+            u8 *o = found[i];
+            u8 attr = o[3];
+            u8 obp = memory[attr & 0x10 ? io_obp1 : io_obp0];
+            int row = ly - (o[0] - 16);
+            int tile = height == 16 ? o[2] & 0xfe : o[2];
+            u8 *px = NULL;
+
+            if (attr & 0x40)
+                row = height - 1 - row;
+            px = tile_row(tile + row / 8, row & 7, attr & 0x20);
+
+            for (int j = 0; j < 8; j += 1) {
+                u8 c = px[j];
+                x = o[1] - 8 + j;
+                if (x < 0 || x >= SCREEN_W || !c)
+                    continue;
+                if ((attr & 0x80) && index[x])
+                    continue;
+                out[x] = (obp >> (c * 2)) & 3;
+            }
+        }
+    }
+}
+
+
+void
+frame_done(void)
+{
+    ppu.frames += 1;
+    hook(frame, ppu.frames);
+    if ((stream.out || stream.trace >= 0) && !stream.every)
+        stream_mark();
+    if (movie.f || joy.has_pending)
+        movie_frame();
+    if (dump.on)
+        dump_frame();
+    if (apu.out)
+        apu_flush();
+    if (cheats.num_freezes)
+        cheat_freeze();
+    if (live.on)
+        live_frame();
+}
+
+
+void
+apu_init(void)
+{
+    const double pi = 3.14159265358979323846;
+
+    /* windowed sinc per sub-sample phase, each phase sums to 1 << 15 */
+    for (int p = 0; p < BLEP_PHASES; p += 1) {
+        double taps[BLEP_TAPS];
+        double total = 0;
+        int sum = 0;
+        int peak = 0;
+
+        for (int k = 0; k < BLEP_TAPS; k += 1) {
+            double x = k - (BLEP_TAPS / 2 - 1) - (double)p / BLEP_PHASES;
+            double w = 0.5 + 0.5 * cos(pi * x / (BLEP_TAPS / 2));
+            double sinc = x == 0 ? 1 : sin(pi * 0.9 * x) / (pi * 0.9 * x);
+            taps[k] = sinc * w;
+            total += taps[k];
+        }
+        for (int k = 0; k < BLEP_TAPS; k += 1) {
+            apu.kernel[p][k] = (i16)floor(taps[k] / total * 32768 + 0.5);
+            sum += apu.kernel[p][k];
+            if (apu.kernel[p][k] > apu.kernel[p][peak])
+                peak = k;
+        }
+        apu.kernel[p][peak] += 32768 - sum;
+    }
+
+    apu.next_seq = 8192;
+    apu.ch[3].lfsr = 0x7fff;
+}
+
+
+static void
+put_le(FILE *f, u32 v, int n)
+{
+    for (int i = 0; i < n; i += 1)
+        fputc((v >> (i * 8)) & 0xff, f);
+}
+
+
+void
+apu_open(const char *path)
+{
+    if (!(apu.out = fopen(path, "wb")))
+        die("open %s failed", path);
+
+    /* sizes are patched in apu_close() */
+    fwrite("RIFF", 4, 1, apu.out);
+    put_le(apu.out, 0, 4);
+    fwrite("WAVEfmt ", 8, 1, apu.out);
+    put_le(apu.out, 16, 4);
+    put_le(apu.out, 1, 2);               /* pcm */
+    put_le(apu.out, 2, 2);               /* stereo */
+    put_le(apu.out, SAMPLE_HZ, 4);
+    put_le(apu.out, SAMPLE_HZ * 4, 4);
+    put_le(apu.out, 4, 2);
+    put_le(apu.out, 16, 2);
+    fwrite("data", 4, 1, apu.out);
+    put_le(apu.out, 0, 4);
+
+    apu_run_to(cpu.cycles);
+    apu.buf_start = cpu.cycles * SAMPLE_HZ / CPU_HZ;
+}
+
+
+void
+apu_close(void)
+{
+    if (!apu.out)
+        return;
+
+    apu_flush();
+    fseek(apu.out, 4, SEEK_SET);
+    put_le(apu.out, 36 + apu.out_bytes, 4);
+    fseek(apu.out, 40, SEEK_SET);
+    put_le(apu.out, apu.out_bytes, 4);
+    if (fclose(apu.out) == EOF)
+        die("close wav failed");
+    apu.out = NULL;
+}
+
+
+int
+apu_period(int c)
+{
+    u8 nr43 = memory[0xff22];
+
+    switch (c) {
+    case 0:
+    case 1:
+        return (2048 - apu.ch[c].freq) * 4;
+
+    case 2:
+        return (2048 - apu.ch[c].freq) * 2;
+
+    default:
+        return ((nr43 & 7) ? (nr43 & 7) * 16 : 8) << (nr43 >> 4);
+    }
+}
+
+
+int
+apu_level(int c)
+{
+    static const u8 duty[4] = {0x01, 0x81, 0x87, 0x7e};
+    Channel *ch = &apu.ch[c];
+    u8 sample = 0;
+
+    if (!ch->on || !ch->dac)
+        return 0;
+
+    switch (c) {
+    case 0:
+    case 1:
+        return (duty[memory[c ? 0xff16 : 0xff11] >> 6] >> ch->pos) & 1 ? ch->volume : 0;
+
+    case 2:
+        sample = memory[0xff30 + ch->pos / 2];
+        sample = ch->pos & 1 ? sample & 0xf : sample >> 4;
+        switch ((memory[0xff1c] >> 5) & 3) {
+        case 0:  return 0;
+        case 1:  return sample;
+        case 2:  return sample >> 1;
+        default: return sample >> 2;
+        }
+
+    default:
+        return ch->lfsr & 1 ? 0 : ch->volume;
+    }
+}
+
+
+void
+apu_delta(int side, u64 time, int delta)
+{
+    u64 t = time * SAMPLE_HZ;
+    u64 index = t / CPU_HZ - apu.buf_start;
+    int phase = (t % CPU_HZ) * BLEP_PHASES / CPU_HZ;
+    i32 *buf = apu.buf[side] + index;
+
+    if (index >= APU_BUF)
+        die("apu buffer overrun");
+
+    for (int k = 0; k < BLEP_TAPS; k += 1)
+        buf[k] += delta * apu.kernel[phase][k];
+}
+
+
+void
+apu_mix(int c, u64 time)
+{
+    Channel *ch = &apu.ch[c];
+    u8 nr50 = memory[0xff24];
+    u8 nr51 = memory[0xff25];
+    int level = apu_level(c);
+    int left  = nr51 & (0x10 << c) ? level * (((nr50 >> 4) & 7) + 1) : 0;
+    int right = nr51 & (0x01 << c) ? level * (((nr50 >> 0) & 7) + 1) : 0;
+
+    if (!apu.out)
+        return;
+
+    /* 4 channels at 15 * 8 stay inside 16 bits at this scale */
+    if (left != ch->left)
+        apu_delta(0, time, (left - ch->left) * 64);
+    if (right != ch->right)
+        apu_delta(1, time, (right - ch->right) * 64);
+
+    ch->left = left;
+    ch->right = right;
+}
+
+
+void
+apu_trigger(int c)
+{
+    Channel *ch = &apu.ch[c];
+    u8 env = memory[c == 0 ? 0xff12 : c == 1 ? 0xff17 : 0xff21];
+
+    ch->on = ch->dac;
+    if (!ch->length)
+        ch->length = c == 2 ? 256 : 64;
+    ch->next_tick = apu.time + apu_period(c);
+    ch->pos = 0;
+
+    if (c != 2) {
+        ch->volume = env >> 4;
+        ch->env_add = env & 0x08;
+        ch->env_period = env & 7;
+        ch->env_timer = ch->env_period;
+    }
+
+    if (c == 3)
+        ch->lfsr = 0x7fff;
+
+    if (c == 0) {
+        u8 nr10 = memory[0xff10];
+        apu.sweep_shadow = ch->freq;
+        apu.sweep_period = (nr10 >> 4) & 7;
+        apu.sweep_timer = apu.sweep_period ? apu.sweep_period : 8;
+        apu.sweep_on = apu.sweep_period || (nr10 & 7);
+    }
+}
+
+
+void
+apu_write(u16 addr, u8 v)
+{
+    Channel *ch = NULL;
+    int c = 0;
+
+    /* everything up to now used the old register values */
+    apu_run_to(cpu.cycles);
+
+    if (!(memory[0xff26] & 0x80) && addr != 0xff26 && addr < 0xff30)
+        return;
+
+    memory[addr] = v;
+
+    switch (addr) {
+    case 0xff11:
+    case 0xff16:
+    case 0xff20:
+        c = addr == 0xff11 ? 0 : addr == 0xff16 ? 1 : 3;
+        apu.ch[c].length = 64 - (v & 0x3f);
+        break;
+
+    case 0xff1b:
+        apu.ch[2].length = 256 - v;
+        break;
+
+    case 0xff12:
+    case 0xff17:
+    case 0xff21:
+        c = addr == 0xff12 ? 0 : addr == 0xff17 ? 1 : 3;
+        apu.ch[c].dac = (v & 0xf8) != 0;
+        if (!apu.ch[c].dac)
+            apu.ch[c].on = false;
+        break;
+
+    case 0xff1a:
+        apu.ch[2].dac = (v & 0x80) != 0;
+        if (!apu.ch[2].dac)
+            apu.ch[2].on = false;
+        break;
+
+    case 0xff13:
+    case 0xff18:
+    case 0xff1d:
+        c = (addr - 0xff13) / 5;
+        apu.ch[c].freq = (apu.ch[c].freq & 0x700) | v;
+        break;
+
+    case 0xff14:
+    case 0xff19:
+    case 0xff1e:
+    case 0xff23:
+        c = (addr - 0xff14) / 5;
+        ch = &apu.ch[c];
+        if (c < 3)
+            ch->freq = (ch->freq & 0xff) | ((v & 7) << 8);
+        ch->length_on = (v & 0x40) != 0;
+        if (v & 0x80)
+            apu_trigger(c);
+        break;
+
+    case 0xff26:
+        memory[addr] = (memory[addr] & 0x7f) | (v & 0x80);
+        if (!(v & 0x80)) {
+            for (c = 0; c < 4; c += 1)
+                apu.ch[c].on = false;
+            memset(memory + 0xff10, 0, 0x16);
+        }
+        break;
+    }
+
+    apu_status();
+
+    if (!apu.out)
+        return;
+    for (c = 0; c < 4; c += 1)
+        apu_mix(c, apu.time);
+}
+
+
+void
+apu_status(void)
+{
+    /* the low bits of NR52 say which channels are playing */
+    u8 on = 0;
+
+    for (int c = 0; c < 4; c += 1)
+        on |= apu.ch[c].on << c;
+    memory[0xff26] = (memory[0xff26] & 0x80) | 0x70 | on;
+}
+
+
+void
+apu_sequencer(void)
+{
+    /* 512Hz: lengths on even steps, sweep on 2 and 6, envelopes on 7 */
+    int step = apu.seq_step;
+    Channel *ch = NULL;
+    int c = 0;
+
+    apu.seq_step = (step + 1) & 7;
+
+    if (!(step & 1)) {
+        for (c = 0; c < 4; c += 1) {
+            ch = &apu.ch[c];
+            if (ch->length_on && ch->length && !--ch->length)
+                ch->on = false;
+        }
+    }
+
+    if ((step == 2 || step == 6) && apu.sweep_on && --apu.sweep_timer <= 0) {
+        u8 nr10 = memory[0xff10];
+        int delta = apu.sweep_shadow >> (nr10 & 7);
+        int freq = nr10 & 0x08 ? apu.sweep_shadow - delta : apu.sweep_shadow + delta;
+
+        apu.sweep_timer = apu.sweep_period ? apu.sweep_period : 8;
+        if (freq > 2047) {
+            apu.ch[0].on = false;
+        } else if (apu.sweep_period && (nr10 & 7)) {
+            apu.sweep_shadow = freq;
+            apu.ch[0].freq = freq;
+        }
+    }
+
+    if (!(step & 1))
+        apu_status();
+
+    if (step == 7) {
+        for (c = 0; c < 4; c += 1) {
+            ch = &apu.ch[c];
+            if (c == 2 || !ch->env_period || --ch->env_timer)
+                continue;
+            ch->env_timer = ch->env_period;
+            if (ch->env_add && ch->volume < 15)
+                ch->volume += 1;
+            else if (!ch->env_add && ch->volume > 0)
+                ch->volume -= 1;
+        }
+    }
+}
+
+
+void
+apu_run_to(u64 end)
+{
+    Channel *ch = NULL;
+    int c = 0;
+
+    while (apu.time < end) {
+        u64 to = end < apu.next_seq ? end : apu.next_seq;
+
+        for (c = 0; c < 4; c += 1) {
+            ch = &apu.ch[c];
+            /* without a -wav only the sequencer's lengths and sweeps matter */
+            if (!ch->on || !apu.out) {
+                ch->next_tick = to;
+                continue;
+            }
+            while (ch->next_tick < to) {
+                if (c == 3) {
+                    u16 bit = (ch->lfsr ^ (ch->lfsr >> 1)) & 1;
+                    ch->lfsr = (ch->lfsr >> 1) | (bit << 14);
+                    if (memory[0xff22] & 0x08)
+                        ch->lfsr = (ch->lfsr & ~0x40) | (bit << 6);
+                } else {
+                    ch->pos = (ch->pos + 1) & (c == 2 ? 31 : 7);
+                }
+                apu_mix(c, ch->next_tick);
+                ch->next_tick += apu_period(c);
+            }
+        }
+
+        apu.time = to;
+        if (to == apu.next_seq) {
+            apu_sequencer();
+            apu.next_seq += 8192;
+            for (c = 0; c < 4 && apu.out; c += 1)
+                apu_mix(c, apu.time);
+        }
+    }
+}
+
+
+void
+apu_drain(void)
+{
+    /* integrate the finished samples, high pass them and write them out */
+    int n = apu.time * SAMPLE_HZ / CPU_HZ - apu.buf_start;
+    i16 out[2];
+
+    for (int i = 0; i < n; i += 1) {
+        for (int side = 0; side < 2; side += 1) {
+            i32 x = 0;
+            i64 y = 0;
+
+            apu.sum[side] += apu.buf[side][i];
+            x = apu.sum[side] >> 15;
+            y = x - apu.hp_in[side] + (((i64)apu.hp_out[side] * 65275) >> 16);
+            apu.hp_in[side] = x;
+            apu.hp_out[side] = (i32)y;
+            out[side] = y > 32767 ? 32767 : y < -32768 ? -32768 : (i16)y;
+        }
+        put_le(apu.out, (u16)out[0], 2);
+        put_le(apu.out, (u16)out[1], 2);
+    }
+    apu.out_bytes += n * 4;
+
+    for (int side = 0; side < 2; side += 1) {
+        memmove(apu.buf[side], apu.buf[side] + n, (APU_BUF + BLEP_TAPS - n) * sizeof(i32));
+        memset(apu.buf[side] + APU_BUF + BLEP_TAPS - n, 0, n * sizeof(i32));
+    }
+    apu.buf_start += n;
+}
+
+
+void
+apu_flush(void)
+{
+    /* in pieces, so a long stretch between frames can't overrun the buffer */
+    u64 chunk = (u64)(APU_BUF / 2) * CPU_HZ / SAMPLE_HZ;
+
+    while (apu.time < cpu.cycles) {
+        apu_run_to(cpu.cycles - apu.time > chunk ? apu.time + chunk : cpu.cycles);
+        apu_drain();
+    }
+}
+
+
+u64
+frame_hash(u8 *px)
+{
+    /* fnv-1a */
+    u64 h = 0xcbf29ce484222325ull;
+
+    for (int i = 0; i < SCREEN_W * SCREEN_H; i += 1) {
+        h ^= px[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+
+#if defined(_WIN32)
+typedef struct Thread_Start {
+    void *(*fn)(void *);
+    void *arg;
+} Thread_Start;
+
+static DWORD WINAPI
+thread_trampoline(LPVOID p)
+{
+    Thread_Start start = *(Thread_Start *)p;
+    free(p);
+    start.fn(start.arg);
+    return 0;
+}
+#endif
+
+
+int
+thread_start(Thread *t, void *(*fn)(void *), void *arg)
+{
+#if defined(_WIN32)
+    Thread_Start *start = malloc(sizeof *start);
+    if (!start)
+        return 1;
+    start->fn = fn;
+    start->arg = arg;
+    *t = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    return *t == NULL;
+#else
+    return pthread_create(t, NULL, fn, arg);
+#endif
+}
+
+
+void
+thread_join(Thread t)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+#else
+    pthread_join(t, NULL);
+#endif
+}
+
+
+void
+thread_sleep(void)
+{
+#if defined(_WIN32)
+    Sleep(1);
+#else
+    struct timespec ts = {0, 1000000};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+
+int
+ring_push(Frame_Ring *r, Dump_Frame *f)
+{
+    uint head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    uint tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (head - tail == DUMP_POOL)
+        return 1;
+
+    r->slot[head % DUMP_POOL] = f;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return 0;
+}
+
+
+Dump_Frame *
+ring_pop(Frame_Ring *r)
+{
+    uint tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    uint head = atomic_load_explicit(&r->head, memory_order_acquire);
+    Dump_Frame *f = NULL;
+
+    if (head == tail)
+        return NULL;
+
+    f = r->slot[tail % DUMP_POOL];
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    return f;
+}
+
+
+void
+dump_open(const char *path, const char *hashes)
+{
+    static char out_buf[1 << 20];
+    const char *ext = path ? strrchr(path, '.') : NULL;
+
+    dump.format = dump_none;
+    if (ext && str_eq(ext, ".rgb"))
+        dump.format = dump_rgb;
+    else if (ext && str_eq(ext, ".ppm"))
+        dump.format = dump_ppm;
+    else if (ext && str_eq(ext, ".y4m"))
+        dump.format = dump_y4m;
+    else if (path)
+        die("-dump wants a .rgb, .ppm or .y4m file: %s", path);
+    /* only .ppm writes a file per frame, the others are one stream */
+    if (path && strchr(path, '%') && dump.format != dump_ppm)
+        die("a %% pattern needs a .ppm dump: %s", path);
+
+    dump.path = path;
+    if (path && !strchr(path, '%')) {
+        if (!(dump.out = fopen(path, "wb")))
+            die("open %s failed", path);
+        setvbuf(dump.out, out_buf, _IOFBF, sizeof out_buf);
+        if (dump.format == dump_y4m)
+            fprintf(dump.out, "YUV4MPEG2 W%d H%d F4194304:70224 Ip A1:1 Cmono\n", SCREEN_W, SCREEN_H);
+    }
+
+    if (hashes && !(dump.hashes = fopen(hashes, "w")))
+        die("open %s failed", hashes);
+
+    for (int i = 0; i < DUMP_POOL; i += 1)
+        ring_push(&dump.free, &dump.pool[i]);
+
+    if (thread_start(&dump.writer, dump_writer, NULL))
+        die("failed to start the writer thread");
+    dump.on = true;
+}
+
+
+void
+dump_frame(void)
+{
+    Dump_Frame *f = NULL;
+
+    /* only waits if the writer is a whole pool of frames behind */
+    while (!(f = ring_pop(&dump.free)))
+        thread_sleep();
+
+    f->number = ppu.frames;
+    memcpy(f->px, ppu.frame, sizeof f->px);
+    ring_push(&dump.full, f);
+}
+
+
+void
+dump_write(Dump_Frame *f)
+{
+    static const u8 shades[4] = {0xff, 0xaa, 0x55, 0x00};
+    static u8 out[SCREEN_H * SCREEN_W * 3];
+    u8 *px = &f->px[0][0];
+    FILE *file = dump.out;
+    char name[512] = "";
+    int n = SCREEN_W * SCREEN_H;
+    int i = 0;
+
+    if (dump.hashes)
+        fprintf(dump.hashes, "%llu %016llx\n", f->number, frame_hash(px));
+
+    switch (dump.format) {
+    case dump_none:
+        return;
+
+    case dump_y4m:
+        for (i = 0; i < n; i += 1)
+            out[i] = shades[px[i]];
+        fprintf(file, "FRAME\n");
+        fwrite(out, n, 1, file);
+        return;
+
+    case dump_ppm:
+        if (!file) {
+            snprintf(name, sizeof name, dump.path, (int)f->number);
+            if (!(file = fopen(name, "wb")))
+                die("open %s failed", name);
+        }
+        fprintf(file, "P6\n%d %d\n255\n", SCREEN_W, SCREEN_H);
+        /* fall through */
+
+    case dump_rgb:
+        for (i = 0; i < n; i += 1) {
+            out[i * 3 + 0] = shades[px[i]];
+            out[i * 3 + 1] = shades[px[i]];
+            out[i * 3 + 2] = shades[px[i]];
+        }
+        fwrite(out, n * 3, 1, file);
+        if (file != dump.out)
+            fclose(file);
+        return;
+
+    default:
+        die("unknown dump format %d", dump.format);
+    }
+}
+
+
+void *
+dump_writer(void *arg)
+{
+    Dump_Frame *f = NULL;
+
+    (void)arg;
+    for (;;) {
+        if (!(f = ring_pop(&dump.full))) {
+            if (atomic_load(&dump.done) && !(f = ring_pop(&dump.full)))
+                break;
+            if (!f) {
+                thread_sleep();
+                continue;
+            }
+        }
+        dump_write(f);
+        ring_push(&dump.free, f);
+    }
+    return NULL;
+}
+
+
+void
+dump_close(void)
+{
+    if (!dump.on)
+        return;
+
+    atomic_store(&dump.done, true);
+    thread_join(dump.writer);
+    dump.on = false;
+
+    if (dump.out && fclose(dump.out) == EOF)
+        die("close %s failed", dump.path);
+    if (dump.hashes && fclose(dump.hashes) == EOF)
+        die("close hashes failed");
+}
+
+
+void
+load_rom(const char *path)
+{
+    FILE *f = NULL;
+    long int filesize = 0;
+
+    if (!(f = fopen(path, "rb")))
+        die("open rom failed");
+
+    fseek(f, 0, SEEK_END);
+    filesize = ftell(f);
+    /*debug_var("d", filesize);*/
+    if (filesize < 0x8000 || filesize % 0x4000)
+        die("rom size %ld isn't a multiple of 16k", filesize);
+
+    rom_size = filesize;
+    if (!(rom = malloc(rom_size)))
+        die("malloc rom failed");
+
+    fseek(f, 0, SEEK_SET);
+    if (fread(rom, rom_size, 1, f) != 1)
+        die("read rom failed");
+
+    if (fclose(f) == EOF)
+        die("close rom failed");
+
+    switch (rom[0x147]) {
+    case 0x00:
+        cart.mbc = 0;
+        break;
+
+    case 0x01:
+    case 0x02:
+    case 0x03:
+        cart.mbc = 1;
+        break;
+
+    case 0x0f:
+    case 0x10:
+    case 0x11:
+    case 0x12:
+    case 0x13:
+        cart.mbc = 3;
+        break;
+
+    case 0x19:
+    case 0x1a:
+    case 0x1b:
+    case 0x1c:
+    case 0x1d:
+    case 0x1e:
+        cart.mbc = 5;
+        break;
+
+    default:
+        die("unsupported cartridge type $%02x", rom[0x147]);
+    }
+
+    switch (rom[0x147]) {
+    case 0x03:
+    case 0x0f:
+    case 0x10:
+    case 0x13:
+    case 0x1b:
+    case 0x1e:
+        cart.battery = true;
+        break;
+    }
+
+    switch (rom[0x149]) {
+    case 0x00: cart.ram_size = 0; break;
+    case 0x01: cart.ram_size = 0x800; break;
+    case 0x02: cart.ram_size = 0x2000; break;
+    case 0x03: cart.ram_size = 0x8000; break;
+    case 0x04: cart.ram_size = 0x20000; break;
+    case 0x05: cart.ram_size = 0x10000; break;
+    default:
+        die("unsupported cart ram size $%02x", rom[0x149]);
+    }
+
+    if (cart.ram_size) {
+        /* starts disabled, without a cart ram $a000 stays plain memory */
+        if (!(cart.ram = calloc(cart.ram_size, 1)))
+            die("calloc cart ram failed");
+        memset(cart_off, 0xff, sizeof cart_off);
+        map_cart_ram();
+    }
+
+    cart.num_rom_banks = rom_size / 0x4000;
+    for (int i = 0; i < 0x40; i += 1) {
+        map.page[i] = rom + i * 0x100;
+        map.attr[i] = page_write_hook;
+        map.attr[0x40 + i] = page_write_hook;
+    }
+    map_rom_bank(1);
+}
+
+
+i32
+disasm_offset(u16 addr, int bank)
+{
+    /* rom offset of a cpu address, -1 for anything outside the rom */
+    i32 offset = -1;
+
+    if (addr < 0x4000)
+        offset = addr;
+    else if (addr < 0x8000)
+        offset = (bank ? bank : 1) * 0x4000 + (addr - 0x4000);
+
+    if (offset >= (i32)rom_size)
+        offset = -1;
+
+    return offset;
+}
+
+
+void
+disasm_queue(u16 addr, int bank)
+{
+    i32 offset = disasm_offset(addr, bank);
+
+    if (offset < 0)
+        return;
+
+    dis.flags[offset] |= DIS_LABEL;
+
+    if (dis.flags[offset] & (DIS_CODE | DIS_OPERAND))
+        return;
+
+    if (dis.num_jobs == dis.max_jobs) {
+        dis.max_jobs = dis.max_jobs ? dis.max_jobs * 2 : 256;
+        dis.jobs = realloc(dis.jobs, dis.max_jobs * sizeof dis.jobs[0]);
+        if (!dis.jobs)
+            die("realloc failed");
+    }
+
+    dis.jobs[dis.num_jobs].offset = offset;
+    dis.jobs[dis.num_jobs].bank = bank;
+    dis.num_jobs += 1;
+}
+
+
+void
+disasm_trace(Disasm_Job job)
+{
+    u32 offset = job.offset;
+    int bank = job.bank;
+    int known_a = -1;
+    u16 addr = 0;
+    u16 target = 0;
+    int i = 0;
+
+    while (offset < rom_size) {
+        u8 *code = rom + offset;
+        Opcode_Info *op = NULL;
+        int len = 0;
+        int stop = false;
+
+        /* operands are only read once they are known to be in the rom */
+        if (*code == 0xcb && offset + 1 >= rom_size)
+            break;
+        op = *code == 0xcb ? &cb_opcode_info[*(code+1)] : &opcode_info[*code];
+        len = *code == 0xcb ? 2 : op->bytes;
+        if (offset + len > rom_size)
+            break;
+
+        /* already decoded from another path */
+        if (dis.flags[offset] & (DIS_CODE | DIS_OPERAND))
+            break;
+
+        /* never run an instruction off the end of a bank */
+        if ((offset % 0x4000) + len > 0x4000)
+            break;
+
+        dis.flags[offset] |= DIS_CODE;
+        for (i = 1; i < len; i += 1)
+            dis.flags[offset + i] |= DIS_OPERAND;
+
+        addr = offset < 0x4000 ? offset : 0x4000 + offset % 0x4000;
+        target  = len > 1 ? *(code+1) << 0 : 0;
+        target += len > 2 ? *(code+2) << 8 : 0;
+
+        switch (op->handler) {
+        case handler_jp:
+            if (op->dst == keyword_hl) {
+                /* jump tables can't be followed statically */
+                stop = true;
+                break;
+            }
+            disasm_queue(target, bank);
+            stop = op->src == keyword_nil;
+            break;
+
+        case handler_jr:
+            target = addr + len + (i8)*(code+1);
+            disasm_queue(target, bank);
+            stop = op->src == keyword_nil;
+            break;
+
+        case handler_call:
+            disasm_queue(target, bank);
+            break;
+
+        case handler_rst:
+            disasm_queue(*code & 0x38, bank);
+            break;
+
+        case handler_ret:
+            stop = op->dst == keyword_nil;
+            break;
+
+        case handler_reti:
+        case handler_illegal:
+            stop = true;
+            break;
+
+        case handler_ld:
+            /* follow 'ld a, n' / 'ld *$2000, a' bank switches */
+            if (op->dst == keyword_a && op->src == keyword_u8) {
+                known_a = *(code+1);
+            } else if (op->dst == keyword_deref_u16 && op->src == keyword_a) {
+                if (known_a >= 0 && 0x2000 <= target && target < 0x4000)
+                    bank = known_a;
+            } else if (op->dst == keyword_a) {
+                known_a = -1;
+            }
+            break;
+
+        default:
+            if (op->dst == keyword_a)
+                known_a = -1;
+            break;
+        }
+
+        if (stop)
+            break;
+
+        offset += len;
+    }
+}
+
+
+void
+disasm_print(FILE *f)
+{
+    u32 offset = 0;
+    u16 addr = 0;
+    int bank = 0;
+    int i = 0;
+
+    for (offset = 0; offset < rom_size; ) {
+        bank = offset / 0x4000;
+        addr = bank ? 0x4000 + offset % 0x4000 : offset;
+
+        if (offset % 0x4000 == 0)
+            fprintf(f, "\n; rom%d\n", bank);
+
+        if (dis.flags[offset] & DIS_LABEL)
+            fprintf(f, "rom%d_%04x:\n", bank, addr);
+
+        fprintf(f, "    rom%d:%04x  ", bank, addr);
+
+        if (dis.flags[offset] & DIS_CODE) {
+            int len = rom[offset] == 0xcb ? 2 : opcode_info[rom[offset]].bytes;
+
+            Code_print(f, rom + offset, addr);
+            /* a jump into the middle of an instruction has nowhere to put its label */
+            for (i = 1; i < len && offset + i < rom_size; i += 1) {
+                if (dis.flags[offset + i] & DIS_LABEL)
+                    fprintf(f, "; rom%d_%04x: is byte %d of the instruction above\n", bank, addr + i, i);
+            }
+            offset += len;
+            continue;
+        }
+
+        /* data, up to 8 bytes per line, split at labels and code */
+        fprintf(f, "db $%02x", rom[offset]);
+        for (i = 1, offset += 1; i < 8 && offset % 0x4000; i += 1, offset += 1) {
+            if (dis.flags[offset] & (DIS_CODE | DIS_LABEL))
+                break;
+            fprintf(f, ", $%02x", rom[offset]);
+        }
+        fprintf(f, "\n");
+    }
+}
+
+
+void
+disasm(void)
+{
+    static char out_buf[1 << 16];
+    u16 entry_points[] = {
+        0x0100,
+        /* rst vectors */
+        0x0000, 0x0008, 0x0010, 0x0018, 0x0020, 0x0028, 0x0030, 0x0038,
+        /* interrupt vectors */
+        0x0040, 0x0048, 0x0050, 0x0058, 0x0060,
+    };
+    size_t i = 0;
+
+    if (!(dis.flags = calloc(rom_size, 1)))
+        die("calloc failed");
+
+    for (i = 0; i < sizeof entry_points / sizeof entry_points[0]; i += 1)
+        disasm_queue(entry_points[i], 1);
+
+    /* every byte is decoded at most once, so this is linear in the rom size */
+    while (dis.num_jobs) {
+        dis.num_jobs -= 1;
+        disasm_trace(dis.jobs[dis.num_jobs]);
+    }
+
+    setvbuf(stdout, out_buf, _IOFBF, sizeof out_buf);
+    disasm_print(stdout);
+    fflush(stdout);
+}
+
+
+void
+example_program(void)
+{
+    print_line_prefix();
+    eval_string("jp $be00 $ef +", true);
+
+    print_line_prefix();
+    eval_string("nop", true);
+
+    print_line_prefix();
+    eval_string("ld a $ff", true);
+
+    print_line_prefix();
+    eval_string("inc b", true);
+
+    print_line_prefix();
+    eval_string("sub b", true);
+
+    print_line_prefix();
+    eval_string("dec b", true);
+
+    print_line_prefix();
+    eval_string("jp nz $100", true);
+
+    print_line_prefix();
+    eval_string("dec a", true);
+}
+
+
+int
+str_eq(const char *s1, const char *s2)
+{
+    return !strcmp(s1, s2);
+}
+
+
+void
+joypad_set(u8 buttons)
+{
+    u8 pressed = buttons & ~joy.buttons;
+    u8 select = ~memory[io_joyp];
+
+    joy.buttons = buttons;
+    if (((select & 0x10) && (pressed & 0x0f)) || ((select & 0x20) && (pressed & 0xf0)))
+        memory[io_if] |= int_mask_joypad;
+}
+
+
+u32
+rom_hash(void)
+{
+    u32 h = 0x811c9dc5;
+
+    for (u32 i = 0; i < rom_size; i += 1) {
+        h ^= rom[i];
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+
+static void
+put_u32(FILE *f, u32 v)
+{
+    for (int i = 0; i < 4; i += 1)
+        fputc((v >> (i * 8)) & 0xff, f);
+}
+
+
+static u32
+get_u32(FILE *f)
+{
+    u32 v = 0;
+
+    for (int i = 0; i < 4; i += 1)
+        v |= (u32)(fgetc(f) & 0xff) << (i * 8);
+    return v;
+}
+
+
+void
+movie_open(const char *path, int recording)
+{
+    char magic[4] = "";
+
+    movie.recording = recording;
+    movie.rom_hash = rom_hash();
+
+    if (recording) {
+        if (!(movie.f = fopen(path, "wb")))
+            die("open %s failed", path);
+        /* the frame count is patched in movie_close() */
+        fwrite("GBMV", 4, 1, movie.f);
+        fputc(MOVIE_VERSION, movie.f);
+        put_u32(movie.f, movie.rom_hash);
+        put_u32(movie.f, 0);
+        return;
+    }
+
+    if (!(movie.f = fopen(path, "rb")))
+        die("open %s failed", path);
+    if (fread(magic, 4, 1, movie.f) != 1 || memcmp(magic, "GBMV", 4))
+        die("%s isn't a movie", path);
+    if (fgetc(movie.f) != MOVIE_VERSION)
+        die("%s is a different movie version", path);
+    if (get_u32(movie.f) != movie.rom_hash)
+        die("%s was recorded with a different rom", path);
+    movie.frames = get_u32(movie.f);
+}
+
+
+u64
+movie_varint(void)
+{
+    u64 v = 0;
+    int c = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        if ((c = fgetc(movie.f)) == EOF)
+            die("movie ends in a record");
+        v |= (u64)(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            break;
+    }
+    return v;
+}
+
+
+void
+movie_put(void)
+{
+    u64 n = movie.run;
+
+    if (!n)
+        return;
+    fputc(movie_joypad, movie.f);
+    fputc(movie.value, movie.f);
+    do {
+        fputc((n & 0x7f) | (n > 0x7f ? 0x80 : 0), movie.f);
+        n >>= 7;
+    } while (n);
+}
+
+
+void
+movie_frame(void)
+{
+    /* the buttons for the frame that is starting */
+    u8 buttons = joy.has_pending ? joy.pending : joy.buttons;
+    int c = 0;
+
+    joy.has_pending = false;
+
+    if (movie.f && !movie.recording) {
+        while (!movie.run) {
+            switch (c = fgetc(movie.f)) {
+            case movie_joypad:
+                movie.value = fgetc(movie.f);
+                movie.run = movie_varint();
+                break;
+
+            case movie_serial:
+                /* a transfer this run didn't make */
+                fgetc(movie.f);
+                break;
+
+            case EOF:
+            case movie_end:
+                /* past the end nothing is held */
+                movie.value = 0;
+                movie.run = (u64)-1;
+                break;
+
+            default:
+                die("bad movie record %02x", c);
+            }
+        }
+        movie.run -= 1;
+        buttons = movie.value;
+    }
+
+    joypad_set(buttons);
+
+    if (movie.f && movie.recording) {
+        if (movie.run && buttons != movie.value) {
+            movie_put();
+            movie.run = 0;
+        }
+        movie.value = buttons;
+        movie.run += 1;
+        movie.frames += 1;
+    }
+}
+
+
+u8
+movie_serial_in(u8 in)
+{
+    /* the frames up to this one are written or read already */
+    if (movie.f && movie.recording) {
+        if (movie.run) {
+            movie_put();
+            movie.run = 0;
+        }
+        fputc(movie_serial, movie.f);
+        fputc(in, movie.f);
+    } else if (movie.f && !movie.run) {
+        int c = fgetc(movie.f);
+        if (c == movie_serial)
+            return fgetc(movie.f);
+        /* recorded without this transfer, the next frame reads it */
+        if (c != EOF)
+            ungetc(c, movie.f);
+    }
+    return in;
+}
+
+
+void
+movie_close(void)
+{
+    if (!movie.f)
+        return;
+
+    if (movie.recording) {
+        movie_put();
+        fputc(movie_end, movie.f);
+        fseek(movie.f, 9, SEEK_SET);
+        put_u32(movie.f, (u32)movie.frames);
+    }
+    if (fclose(movie.f) == EOF)
+        die("close movie failed");
+    movie.f = NULL;
+}
+
+
+void
+state_save(Savestate *st)
+{
+    st->cpu = cpu;
+    st->reg = reg;
+    st->sched = sched;
+    st->idle = idle;
+    st->map = map;
+    st->cart = cart;
+    st->timer = timer;
+    st->joy = joy;
+    st->ppu = ppu;
+    memcpy(st->ch, apu.ch, sizeof st->ch);
+    st->sweep[0] = apu.sweep_period;
+    st->sweep[1] = apu.sweep_timer;
+    st->sweep[2] = apu.sweep_shadow;
+    st->sweep[3] = apu.sweep_on;
+    st->apu_time = apu.time;
+    st->apu_next_seq = apu.next_seq;
+    st->apu_seq_step = apu.seq_step;
+    memcpy(st->memory, memory, sizeof memory);
+    if (cart.ram_size) {
+        if (!st->cart_ram && !(st->cart_ram = malloc(cart.ram_size)))
+            die("malloc savestate cart ram failed");
+        memcpy(st->cart_ram, cart.ram, cart.ram_size);
+    }
+}
+
+
+void
+state_load(Savestate *st)
+{
+    /* write out what was heard so far, the wav goes on from the new time */
+    if (apu.out)
+        apu_drain();
+
+    cpu = st->cpu;
+    reg = st->reg;
+    sched = st->sched;
+    idle = st->idle;
+    map = st->map;
+    cart = st->cart;
+    timer = st->timer;
+    joy = st->joy;
+    ppu = st->ppu;
+    memcpy(apu.ch, st->ch, sizeof st->ch);
+    apu.sweep_period = st->sweep[0];
+    apu.sweep_timer = st->sweep[1];
+    apu.sweep_shadow = st->sweep[2];
+    apu.sweep_on = st->sweep[3];
+    apu.time = st->apu_time;
+    apu.next_seq = st->apu_next_seq;
+    apu.seq_step = st->apu_seq_step;
+    if (apu.out) {
+        for (int side = 0; side < 2; side += 1)
+            memset(apu.buf[side], 0, sizeof apu.buf[side]);
+        apu.buf_start = apu.time * SAMPLE_HZ / CPU_HZ;
+    }
+    memcpy(memory, st->memory, sizeof memory);
+    if (st->cart_ram)
+        memcpy(cart.ram, st->cart_ram, cart.ram_size);
+    memset(tiles.dirty, true, sizeof tiles.dirty);
+    memset(map.dirty, true, sizeof map.dirty);
+}
+
+
+void
+cover_open(void)
+{
+    if (!(cover.blocks = calloc((rom_size + 0x10000) / 8, 1)))
+        die("out of memory");
+    for (int i = 0; i < 256; i += 1) {
+        switch (opcode_info[i].handler) {
+        case handler_jp:
+        case handler_jr:
+        case handler_call:
+        case handler_rst:
+        case handler_ret:
+        case handler_reti:
+            cover.ends[i] = true;
+            break;
+        }
+    }
+    global.step_extras |= step_cover;
+}
+
+
+void
+step_extras(u16 pc, u8 *code)
+{
+    if (cpu.halted && reg.wr.pc == pc)
+        return;
+
+    if (global.step_extras & step_cover)
+        cover_step(pc, code);
+
+    if ((global.step_extras & step_count) && ++stream.count == stream.every) {
+        stream.count = 0;
+        stream_mark();
+    }
+
+    if (global.step_extras & step_trace)
+        trace_line(stdout);
+
+    if (global.step_extras & step_check)
+        check_step(pc, code);
+
+    if (global.step_extras & step_heat)
+        heat.count[heat_fetch][heat_page(pc)] += 1;
+}
+
+
+void
+cover_step(u16 pc, u8 *code)
+{
+    /* the cb prefix entry is one byte, the instructions behind it are two */
+    u16 len = code[0] == 0xcb ? 2 : opcode_info[code[0]].bytes;
+
+    if (cover.ends[code[0]] || reg.wr.pc != (u16)(pc + len))
+        cover_block(reg.wr.pc);
+}
+
+
+void
+cover_block(u16 pc)
+{
+    u32 at = pc < 0x8000
+        ? map.rom_offset[pc >> 8] + (pc & 0xff)
+        : rom_size + pc;
+    u32 cur = (at * 0x9e3779b1u) >> 16;
+
+    cover.blocks[at >> 3] |= 1 << (at & 7);
+    cover.edges[(cur ^ cover.prev) & (COVER_EDGES - 1)] += 1;
+    cover.prev = cur >> 1;
+}
+
+
+u64
+fuzz_rand(void)
+{
+    /* xorshift64*, seeded the same every run */
+    fuzz.rng ^= fuzz.rng >> 12;
+    fuzz.rng ^= fuzz.rng << 25;
+    fuzz.rng ^= fuzz.rng >> 27;
+    return fuzz.rng * 0x2545f4914f6cdd1dull;
+}
+
+
+void
+fuzz_mutate(u8 *input, int from, int frames)
+{
+    /* only frames from `from` on change */
+    int n = 1 + fuzz_rand() % 4;
+
+    while (n--) {
+        int at = from + fuzz_rand() % (frames - from);
+        int len = 1 + fuzz_rand() % 16;
+        u8 *other = fuzz.corpus[fuzz_rand() % fuzz.corpus_len].joy;
+
+        switch (fuzz_rand() % 4) {
+        case 0:
+            input[at] ^= 1 << (fuzz_rand() % 8);
+            break;
+
+        case 1:
+            /* hold one value for a while, the way a player does */
+            for (u8 v = fuzz_rand(); len-- && at < frames; at += 1)
+                input[at] = v;
+            break;
+
+        case 2:
+            for (; len-- && at < frames; at += 1)
+                input[at] = 0;
+            break;
+
+        default:
+            for (; len-- && at < frames; at += 1)
+                input[at] = other[at];
+            break;
+        }
+    }
+}
+
+
+void
+fuzz_frames(u8 *input, int from, int to)
+{
+    for (int f = from; f < to; f += 1) {
+        u64 frame = ppu.frames;
+        joypad_set(input[f]);
+        while (ppu.frames == frame)
+            step(false);
+    }
+}
+
+
+int
+fuzz_novel(void)
+{
+    int found = 0;
+
+    for (int i = 0; i < COVER_EDGES; i += 1) {
+        /* hit counts bucketed as in afl: 1 2 3 4-7 8-15 16-31 32-127 128+ */
+        u8 n = cover.edges[i];
+        u8 b = 0;
+
+        if (!n)
+            continue;
+        b = n < 4 ? 1 << (n - 1)
+          : n < 8 ? 8
+          : n < 16 ? 16
+          : n < 32 ? 32
+          : n < 128 ? 64
+          : 128;
+        if (b & ~fuzz.seen[i]) {
+            fuzz.seen[i] |= b;
+            found = true;
+        }
+    }
+    return found;
+}
+
+
+void
+fuzz_keep(u8 *input, int frames)
+{
+    if (fuzz.corpus_len == MAX_CORPUS)
+        return;
+    if (!(fuzz.corpus[fuzz.corpus_len].joy = malloc(frames)))
+        die("out of memory");
+    memcpy(fuzz.corpus[fuzz.corpus_len].joy, input, frames);
+    fuzz.corpus_len += 1;
+}
+
+
+int
+fuzz_exec(u8 *input, int frames)
+{
+    state_load(&fuzz.start);
+    memset(cover.edges, 0, sizeof cover.edges);
+    cover.prev = 0;
+
+    fuzz_frames(input, 0, frames);
+    fuzz.execs += 1;
+    return fuzz_novel();
+}
+
+
+void
+fuzz_batch(int frames)
+{
+    /*
+     * All the lanes of a batch are mutated from one parent at or after the
+     * same frame, so they are the same machine up to there. That part runs
+     * once, then each lane goes on from a savestate at the fork with a copy
+     * of the coverage so far.
+     */
+    u8 *parent = fuzz.corpus[fuzz_rand() % fuzz.corpus_len].joy;
+    int at = fuzz_rand() % frames;
+    int lane = 0;
+
+    for (lane = 0; lane < fuzz.lanes; lane += 1) {
+        memcpy(fuzz.lane_input[lane], parent, frames);
+        fuzz_mutate(fuzz.lane_input[lane], at, frames);
+    }
+
+    state_load(&fuzz.start);
+    memset(cover.edges, 0, sizeof cover.edges);
+    cover.prev = 0;
+    fuzz_frames(parent, 0, at);
+
+    state_save(&fuzz.fork);
+    memcpy(fuzz.fork_edges, cover.edges, sizeof cover.edges);
+    fuzz.fork_prev = cover.prev;
+
+    for (lane = 0; lane < fuzz.lanes; lane += 1) {
+        if (lane) {
+            state_load(&fuzz.fork);
+            memcpy(cover.edges, fuzz.fork_edges, sizeof cover.edges);
+            cover.prev = fuzz.fork_prev;
+        }
+        fuzz_frames(fuzz.lane_input[lane], at, frames);
+        fuzz.execs += 1;
+        if (fuzz_novel())
+            fuzz_keep(fuzz.lane_input[lane], frames);
+    }
+}
+
+
+void
+fuzz_run(u64 execs, int frames)
+{
+    clock_t start = clock();
+    double secs = 0;
+    int edges = 0;
+    int blocks = 0;
+
+    cover_open();
+    global.no_render = true;
+    fuzz.rng = 0x9e3779b97f4a7c15ull;
+    state_save(&fuzz.start);
+
+    if (!(fuzz.input = malloc(frames)))
+        die("out of memory");
+    for (int i = 0; i < fuzz.lanes; i += 1) {
+        if (!(fuzz.lane_input[i] = malloc(frames)))
+            die("out of memory");
+    }
+    if (!(fuzz.corpus[0].joy = calloc(frames, 1)))
+        die("out of memory");
+    fuzz.corpus_len = 1;
+    fuzz_exec(fuzz.corpus[0].joy, frames);
+
+    while (fuzz.execs < execs) {
+        if (fuzz.lanes > 1) {
+            fuzz_batch(frames);
+            continue;
+        }
+        memcpy(fuzz.input, fuzz.corpus[fuzz_rand() % fuzz.corpus_len].joy, frames);
+        fuzz_mutate(fuzz.input, 0, frames);
+        if (fuzz_exec(fuzz.input, frames))
+            fuzz_keep(fuzz.input, frames);
+    }
+
+    secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    for (int i = 0; i < COVER_EDGES; i += 1)
+        edges += fuzz.seen[i] != 0;
+    for (u32 i = 0; i < (rom_size + 0x10000) / 8; i += 1)
+        for (u8 b = cover.blocks[i]; b; b &= b - 1)
+            blocks += 1;
+    printf("execs %llu, %.0f/s, corpus %d, edges %d, blocks %d\n",
+            fuzz.execs, secs > 0 ? fuzz.execs / secs : 0, fuzz.corpus_len, edges, blocks);
+}
+
+
+u64
+state_hash(void)
+{
+    /* fnv-1a over what decides the next instruction */
+    u64 h = 0xcbf29ce484222325ull;
+    u8 *p = (u8 *)&reg;
+
+    for (size_t i = 0; i < offsetof(union registers, wr.deref_hl); i += 1) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    for (int i = 0; i < 8; i += 1) {
+        h ^= (cpu.cycles >> (i * 8)) & 0xff;
+        h *= 0x100000001b3ull;
+    }
+    for (int i = 0; i < 0x10000; i += 1) {
+        h ^= *peek8ptr(i);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+
+u64
+page_hash(u8 *p)
+{
+    u64 h = 0x9e3779b97f4a7c15ull;
+    u64 w = 0;
+
+    for (int i = 0; i < 0x100; i += 8) {
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+    return h;
+}
+
+
+void
+stream_open(const char *path, u64 every)
+{
+    stream.every = every;
+    if (every)
+        global.step_extras |= step_count;
+    memset(map.dirty, true, sizeof map.dirty);
+
+    if (!path)
+        return;
+    if (!(stream.out = fopen(path, "wb")))
+        die("open %s failed", path);
+    fwrite("GBSH", 4, 1, stream.out);
+    fputc(STREAM_VERSION, stream.out);
+    put_u32(stream.out, (u32)every);
+}
+
+
+void
+stream_mark(void)
+{
+    /* end of an interval, hash it and start or stop tracing */
+    u64 h = 0xcbf29ce484222325ull;
+    u8 *p = (u8 *)&reg;
+
+    if (stream.out) {
+        for (size_t i = 0; i < offsetof(union registers, wr.deref_hl); i += 1)
+            h = (h ^ p[i]) * 0x100000001b3ull;
+        h = (h ^ cpu.cycles) * 0x100000001b3ull;
+        h = (h ^ cpu.ei) * 0x100000001b3ull;
+
+        for (int i = 0; i < 0x100; i += 1) {
+            if (i < 0x80) {
+                h = (h ^ map.rom_offset[i]) * 0x100000001b3ull;
+                continue;
+            }
+            /* io changes behind poke8's back, so it is always redone */
+            if (map.dirty[i] || i == 0xff) {
+                stream.page[i] = page_hash(map.page[i]);
+                map.dirty[i] = false;
+            }
+            h = (h ^ stream.page[i]) * 0x100000001b3ull;
+        }
+        put_u32(stream.out, (u32)h);
+        put_u32(stream.out, (u32)(h >> 32));
+    }
+
+    stream.index += 1;
+    if (stream.trace < 0)
+        return;
+    if ((i64)stream.index == stream.trace) {
+        /* step_extras prints the first line at the end of this step */
+        global.step_extras |= step_trace;
+    } else if ((i64)stream.index > stream.trace) {
+        stream_close();
+        exit(0);
+    }
+}
+
+
+void
+stream_close(void)
+{
+    if (!stream.out)
+        return;
+    if (fclose(stream.out) == EOF)
+        die("close state hashes failed");
+    stream.out = NULL;
+}
+
+
+void
+trace_line(FILE *f)
+{
+    /* gameboy-doctor's layout */
+    u16 pc = reg.wr.pc;
+
+    fprintf(f, "A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X "
+            "SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X\n",
+            reg.br.a, reg.br.f, reg.br.b, reg.br.c, reg.br.d, reg.br.e,
+            reg.br.h, reg.br.l, reg.wr.sp, pc,
+            *peek8ptr(pc), *peek8ptr(pc + 1), *peek8ptr(pc + 2), *peek8ptr(pc + 3));
+}
+
+
+void
+trace_fields(u8 *out)
+{
+    /* in the order of a trace line */
+    u16 pc = reg.wr.pc;
+
+    out[0] = reg.br.a;
+    out[1] = reg.br.f;
+    out[2] = reg.br.b;
+    out[3] = reg.br.c;
+    out[4] = reg.br.d;
+    out[5] = reg.br.e;
+    out[6] = reg.br.h;
+    out[7] = reg.br.l;
+    out[8] = reg.wr.sp >> 8;
+    out[9] = reg.wr.sp & 0xff;
+    out[10] = pc >> 8;
+    out[11] = pc & 0xff;
+    for (int i = 0; i < 4; i += 1)
+        out[12 + i] = *peek8ptr(pc + i);
+}
+
+
+static int
+hex_byte(const char *s)
+{
+    int v = 0;
+
+    for (int i = 0; i < 2; i += 1) {
+        int c = s[i];
+        v <<= 4;
+        if ('0' <= c && c <= '9')
+            v |= c - '0';
+        else if ('a' <= (c | 0x20) && (c | 0x20) <= 'f')
+            v |= (c | 0x20) - 'a' + 10;
+        else
+            return -1;
+    }
+    return v;
+}
+
+
+void
+check_open(const char *path)
+{
+    if (!(check.in = fopen(path, "r")))
+        die("open %s failed", path);
+    /* big reads, the trace can be far bigger than memory */
+    setvbuf(check.in, NULL, _IOFBF, CHECK_BUF);
+
+    /* fast forward skips instructions the trace has lines for */
+    global.no_fast_forward = true;
+    global.step_extras |= step_check;
+    atexit(check_close);
+}
+
+
+void
+check_step(u16 pc, u8 *code)
+{
+    /*
+     * Fixed columns: A:00 F:00 B:00 C:00 D:00 E:00 H:00 L:00 SP:0000
+     * PC:0000 PCMEM:00,00,00,00
+     */
+    static const u8 at[16] = {2, 7, 12, 17, 22, 27, 32, 37, 43, 45, 51, 53, 62, 65, 68, 71};
+    char *text = check.text[check.line % CHECK_CONTEXT];
+    u8 want[16];
+    u8 got[16];
+    int i = 0;
+
+    if (!fgets(text, sizeof check.text[0], check.in))
+        exit(0);
+    if (strlen(text) < 73 || text[0] != 'A' || text[56] != 'P')
+        die("line %llu isn't a gameboy-doctor trace line", check.line + 1);
+    for (i = 0; i < 16; i += 1) {
+        int v = hex_byte(text + at[i]);
+        if (v < 0)
+            die("bad hex on line %llu", check.line + 1);
+        want[i] = v;
+    }
+
+    /* the line before this one is followed by the instruction just run */
+    if (check.line) {
+        check.pc[(check.line - 1) % CHECK_CONTEXT] = pc;
+        memcpy(check.code[(check.line - 1) % CHECK_CONTEXT], code, 3);
+    }
+
+    trace_fields(got);
+    if (memcmp(want, got, sizeof got)) {
+        fprintf(stderr, "\nmismatch on line %llu of the trace\n\n", check.line + 1);
+        for (i = CHECK_CONTEXT - 1; i > 0; i -= 1) {
+            u64 n = check.line - i;
+            if (check.line < (u64)i)
+                continue;
+            fprintf(stderr, "  %s", check.text[n % CHECK_CONTEXT]);
+            fprintf(stderr, "    ");
+            Code_print(stderr, check.code[n % CHECK_CONTEXT], check.pc[n % CHECK_CONTEXT]);
+        }
+        fprintf(stderr, "want %s", text);
+        fprintf(stderr, "got  ");
+        trace_line(stderr);
+        fprintf(stderr, "\n");
+        print_line_prefix();
+        fflush(stdout);
+        Code_repr(got + 12);
+        fprintf(stderr, "\n");
+        check.in = NULL;
+        exit(1);
+    }
+    check.line += 1;
+}
+
+
+void
+check_close(void)
+{
+    if (!check.in)
+        return;
+    printf("%llu trace lines match\n", check.line);
+    fflush(stdout);
+    fclose(check.in);
+    check.in = NULL;
+}
+
+
+int
+bisect(char **argv)
+{
+    /*
+     * -bisect BUILD_A BUILD_B ARGS... runs both emulator builds on the same
+     * ARGS with -state-hashes, finds the first interval where the streams
+     * differ, then runs both again with -trace-interval on just that one
+     * and reports the first instruction where the traces part.
+     */
+    char paths[4][64];
+    char index_buf[24] = "";
+    u64 index = 0;
+    int same = 0;
+
+#if defined(_WIN32)
+    (void)argv;
+    (void)paths;
+    (void)index_buf;
+    (void)index;
+    (void)same;
+    die("-bisect needs fork()");
+#else
+    static const char *names[4] = {"a.hashes", "b.hashes", "a.trace", "b.trace"};
+
+    for (int i = 0; i < 4; i += 1)
+        snprintf(paths[i], sizeof paths[i], "/tmp/gb-bisect-%d-%s", (int)getpid(), names[i]);
+
+    bisect_run(argv[0], argv + 2, "-state-hashes", paths[0], "/dev/null");
+    bisect_run(argv[1], argv + 2, "-state-hashes", paths[1], "/dev/null");
+    same = bisect_streams(paths[0], paths[1], &index);
+    remove(paths[0]);
+    remove(paths[1]);
+    if (same)
+        return 0;
+
+    snprintf(index_buf, sizeof index_buf, "%llu", index);
+    bisect_run(argv[0], argv + 2, "-trace-interval", index_buf, paths[2]);
+    bisect_run(argv[1], argv + 2, "-trace-interval", index_buf, paths[3]);
+    bisect_traces(paths[2], paths[3], index);
+    remove(paths[2]);
+    remove(paths[3]);
+    return 1;
+#endif
+}
+
+
+void
+bisect_run(const char *build, char **args, const char *opt, const char *value, const char *out)
+{
+    /* build ARGS... OPT VALUE with its stdout in out */
+#if defined(_WIN32)
+    (void)build;
+    (void)args;
+    (void)opt;
+    (void)value;
+    (void)out;
+#else
+    char *child[256];
+    int n = 0;
+    int status = 0;
+    pid_t pid = 0;
+
+    child[n++] = (char *)build;
+    while (*args && n < 253)
+        child[n++] = *args++;
+    if (*args)
+        die("-bisect: too many arguments");
+    child[n++] = (char *)opt;
+    child[n++] = (char *)value;
+    child[n] = NULL;
+
+    fflush(stdout);
+    if ((pid = fork()) < 0)
+        die("fork failed");
+    if (!pid) {
+        int fd = open(out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || dup2(fd, 1) < 0)
+            _exit(127);
+        execv(build, child);
+        _exit(127);
+    }
+    if (waitpid(pid, &status, 0) < 0)
+        die("waitpid failed");
+    if (!WIFEXITED(status) || WEXITSTATUS(status))
+        die("%s failed with status %d", build, status);
+#endif
+}
+
+
+int
+bisect_streams(const char *a, const char *b, u64 *index)
+{
+    /* the first interval where two hash streams differ, true if none does */
+    FILE *fa = fopen(a, "rb");
+    FILE *fb = fopen(b, "rb");
+    u8 ha[4096];
+    u8 hb[4096];
+    size_t na = 0;
+    size_t nb = 0;
+
+    *index = 0;
+    if (!fa || !fb)
+        die("open %s failed", fa ? b : a);
+    if (fread(ha, 9, 1, fa) != 1 || fread(hb, 9, 1, fb) != 1
+            || memcmp(ha, "GBSH", 4) || memcmp(hb, "GBSH", 4))
+        die("not state hash files");
+    if (memcmp(ha, hb, 9))
+        die("the streams were taken with different intervals");
+
+    for (;;) {
+        na = fread(ha, 8, sizeof ha / 8, fa);
+        nb = fread(hb, 8, sizeof hb / 8, fb);
+        for (size_t i = 0; i < na && i < nb; i += 1, *index += 1) {
+            if (memcmp(ha + i * 8, hb + i * 8, 8))
+                goto differ;
+        }
+        if (na != nb) {
+            printf("same up to interval %llu, then one stream ends\n", *index);
+            goto differ;
+        }
+        if (!na)
+            break;
+    }
+    fclose(fa);
+    fclose(fb);
+    printf("same for all %llu intervals\n", *index);
+    return true;
+
+differ:
+    fclose(fa);
+    fclose(fb);
+    printf("first difference in interval %llu\n", *index);
+    return false;
+}
+
+
+int
+bisect_traces(const char *a, const char *b, u64 index)
+{
+    /* trace lines only, anything else the builds print is skipped */
+    FILE *fa = fopen(a, "r");
+    FILE *fb = fopen(b, "r");
+    char la[256] = "";
+    char lb[256] = "";
+    char prev[256] = "";
+    u64 n = 0;
+    int ok = true;
+
+    if (!fa || !fb)
+        die("open %s failed", fa ? b : a);
+
+    for (;;) {
+        char *ra = NULL;
+        char *rb = NULL;
+        while ((ra = fgets(la, sizeof la, fa)) && strncmp(la, "A:", 2))
+            ;
+        while ((rb = fgets(lb, sizeof lb, fb)) && strncmp(lb, "A:", 2))
+            ;
+        if (!ra && !rb)
+            break;
+        if (!ra || !rb || strcmp(la, lb)) {
+            ok = false;
+            printf("first divergent instruction is %llu in interval %llu\n", n, index);
+            if (n)
+                printf("  after  %s", prev);
+            printf("  a      %s", ra ? la : "(trace ends)\n");
+            printf("  b      %s", rb ? lb : "(trace ends)\n");
+            break;
+        }
+        memcpy(prev, la, sizeof prev);
+        n += 1;
+    }
+    if (ok)
+        printf("the %llu traced instructions agree, the difference is in memory\n", n);
+    fclose(fa);
+    fclose(fb);
+    return ok;
+}
+
+
+void
+serve(i32 until_pc, u64 frames)
+{
+    /*
+     * Boot once, then fork a child per line on stdin. The child gets the
+     * booted machine copy on write, so a job costs a fork instead of the
+     * boot. A job is a frame count and optional joypad bytes in hex, one
+     * per frame: "60 00000004040400". Each gets one line back.
+     */
+    char line_buf[4096] = "";
+
+#if defined(_WIN32)
+    (void)until_pc;
+    (void)frames;
+    (void)line_buf;
+    die("-serve needs fork()");
+#else
+    if (until_pc >= 0) {
+        while (reg.wr.pc != until_pc)
+            step(false);
+    } else {
+        while (ppu.frames < frames)
+            step(false);
+    }
+    printf("ready frame %llu pc $%04x\n", ppu.frames, reg.wr.pc);
+    fflush(stdout);
+
+    while (fgets(line_buf, sizeof line_buf, stdin)) {
+        pid_t pid = 0;
+        int status = 0;
+
+        if (line_buf[0] == '\n')
+            continue;
+        if ((pid = fork()) < 0)
+            die("fork failed");
+        if (!pid) {
+            serve_job(line_buf);
+            fflush(stdout);
+            _exit(0);
+        }
+        if (waitpid(pid, &status, 0) < 0)
+            die("waitpid failed");
+        if (!WIFEXITED(status) || WEXITSTATUS(status))
+            printf("failed %d\n", status);
+        fflush(stdout);
+    }
+#endif
+}
+
+
+void
+serve_job(char *line)
+{
+    char *in = line;
+    char word[16] = "";
+    i32 frames = 0;
+    u64 end = 0;
+
+    in += read_token(word, in, sizeof word);
+    chomp(&in, ' ');
+    if (parse_number(&frames, word) || frames < 0) {
+        printf("bad job: %s", line);
+        return;
+    }
+
+    end = ppu.frames + frames;
+    while (ppu.frames < end) {
+        u64 frame = ppu.frames;
+        u8 buttons = 0;
+        if (isxdigit(in[0]) && isxdigit(in[1])) {
+            sscanf(in, "%2hhx", &buttons);
+            in += 2;
+        }
+        joypad_set(buttons);
+        while (ppu.frames == frame)
+            step(false);
     }
 
+    printf("done frame %llu pc $%04x state %016llx screen %016llx\n",
+            ppu.frames, reg.wr.pc, state_hash(), frame_hash(&ppu.frame[0][0]));
+}
 
-    switch (op->words[0]) {
-    case keyword_jp:
-    case keyword_jr:
-    case keyword_call:
-    case keyword_ret:
-    case keyword_reti:
-    case keyword_rst:
-        break;
-    default:
-        reg.wr.pc += op->bytes;
+
+#if GB_HOOKS
+/* an example user of the hooks, -hook-stats */
+struct hook_stats {
+    u64 instructions;
+    u64 reads;
+    u64 writes;
+    u64 interrupts[5];
+    u64 frames;
+    u64 page_writes[0x100];
+} hook_stats;
+
+
+void
+stats_instruction(void *ctx, u16 pc, u8 *code)
+{
+    struct hook_stats *st = ctx;
+    (void)pc;
+    (void)code;
+    st->instructions += 1;
+}
+
+
+void
+stats_read(void *ctx, u16 addr, u8 v)
+{
+    struct hook_stats *st = ctx;
+    (void)addr;
+    (void)v;
+    st->reads += 1;
+}
+
+
+void
+stats_write(void *ctx, u16 addr, u8 v)
+{
+    struct hook_stats *st = ctx;
+    st->writes += 1;
+    st->page_writes[addr >> 8] += 1;
+    if (addr < 0x8000)
+        fprintf(stderr, "mbc write $%02x to $%04x, pc $%04x\n", v, addr, reg.wr.pc);
+}
+
+
+void
+stats_interrupt(void *ctx, int i)
+{
+    struct hook_stats *st = ctx;
+    st->interrupts[i] += 1;
+}
+
+
+void
+stats_frame(void *ctx, u64 frame)
+{
+    struct hook_stats *st = ctx;
+    st->frames = frame;
+}
+
+
+void
+stats_print(void)
+{
+    struct hook_stats *st = &hook_stats;
+
+    fprintf(stderr, "instructions %llu\n", st->instructions);
+    fprintf(stderr, "reads        %llu\n", st->reads);
+    fprintf(stderr, "writes       %llu\n", st->writes);
+    fprintf(stderr, "frames       %llu\n", st->frames);
+    for (int i = 0; i < 5; i += 1)
+        fprintf(stderr, "interrupt %d  %llu\n", i, st->interrupts[i]);
+    for (int i = 0; i < 0x100; i += 1) {
+        if (st->page_writes[i])
+            fprintf(stderr, "page $%02x    %llu writes\n", i, st->page_writes[i]);
     }
 }
 
 
 void
-example_program(void)
+stats_install(void)
 {
-    print_line_prefix();
-    eval_string("jp $be00 $ef +", true);
+    hooks.ctx = &hook_stats;
+    hooks.instruction = stats_instruction;
+    hooks.read = stats_read;
+    hooks.write = stats_write;
+    hooks.interrupt = stats_interrupt;
+    hooks.frame = stats_frame;
+    atexit(stats_print);
+}
+#endif
 
-    print_line_prefix();
-    eval_string("nop", true);
 
-    print_line_prefix();
-    eval_string("ld a $ff", true);
+void
+live_open(int hz)
+{
+    if (!(live.scratch = tmpfile()))
+        die("live view needs a scratch file");
+    live.on = true;
+    live.period = 1000000000ull / hz;
+    live.last_ns = mono_ns();
+    live.next = live.last_ns;
+    live.full = true;
+    memcpy(&live.old, &reg, sizeof(reg));
+
+    signal(SIGINT, live_quit);
+    atexit(live_close);
+
+    /* alternate screen, hidden cursor */
+    printf(ESC "[?1049h" ESC "[?25l" ESC "[2J");
+    fflush(stdout);
+}
 
-    print_line_prefix();
-    eval_string("inc b", true);
 
-    print_line_prefix();
-    eval_string("sub b", true);
+void
+live_close(void)
+{
+    if (!live.on)
+        return;
+    live.on = false;
+    printf(RESET ESC "[?25h" ESC "[?1049l");
+    fflush(stdout);
+}
 
-    print_line_prefix();
-    eval_string("dec b", true);
 
-    print_line_prefix();
-    eval_string("jp nz $100", true);
+void
+live_quit(int sig)
+{
+    (void)sig;
+    live.quit = true;
+}
 
-    print_line_prefix();
-    eval_string("dec a", true);
+
+void
+live_frame(void)
+{
+    u64 now = mono_ns();
+
+    if (now < live.next)
+        return;
+
+    if (now > live.last_ns)
+        live.fps = (ppu.frames - live.last_frames) * 1e9 / (now - live.last_ns);
+    live.last_ns = now;
+    live.last_frames = ppu.frames;
+
+    live_draw();
+
+    /* don't try to catch up after a slow redraw */
+    live.next += live.period;
+    if (live.next < now)
+        live.next = now + live.period;
+}
+
+
+void
+live_draw(void)
+{
+    static char out[LIVE_ROWS * (LIVE_COLS + 16)];
+    char (*rows)[LIVE_COLS] = live.rows[live.front ^ 1];
+    char (*shown)[LIVE_COLS] = live.rows[live.front];
+    char *o = out;
+    int r = 0;
+    u16 addr = reg.wr.pc;
+    u16 mem = (reg.wr.hl & 0xfff0) - 0x30;
+
+    memset(rows, 0, sizeof(live.rows[0]));
+
+    snprintf(rows[r++], LIVE_COLS, "frame %llu  %.0f fps (%.1fx)%s",
+             ppu.frames, live.fps, live.fps / 59.7275,
+             cpu.halted ? "  halted" : "");
+    r += 1;
+
+    snprintf(rows[r++], LIVE_COLS, " a  znhc bc   de   hl   *hl  bank:offset");
+    format_line_prefix(rows[r++], &live.old);
+    memcpy(&live.old, &reg, sizeof(reg));
+    r += 1;
+
+    for (int i = 0; i < LIVE_CODE; i += 1) {
+        u8 code[3];
+        char text[LIVE_COLS] = "";
+
+        for (int j = 0; j < 3; j += 1)
+            code[j] = *peek8ptr(addr + j);
+
+        rewind(live.scratch);
+        Code_print(live.scratch, code, addr);
+        rewind(live.scratch);
+        if (!fgets(text, sizeof(text), live.scratch))
+            text[0] = '\0';
+        text[strcspn(text, "\n")] = '\0';
+
+        snprintf(rows[r++], LIVE_COLS, "%s%s%04x  %s" RESET,
+                 i ? "   " : CTEXT(BRIGHT_YELLOW_TEXT, " > "),
+                 i ? "" : ESC "[" WHITE_TEXT "m",
+                 addr, text);
+        addr += Opcode_from_code(code)->bytes;
+    }
+    r += 1;
+
+    for (int i = 0; i < LIVE_MEM && r < LIVE_ROWS; i += 1) {
+        char *p = rows[r++];
+        u16 at = mem + i * 16;
+
+        p += sprintf(p, " %04x ", at);
+        for (int j = 0; j < 16; j += 1) {
+            u16 a = at + j;
+            p += sprintf(p, a == reg.wr.hl ? ESC "[" WHITE_TEXT "m %02x" RESET : " %02x",
+                         *peek8ptr(a));
+        }
+    }
+
+    /* only the rows that changed go to the terminal */
+    for (r = 0; r < LIVE_ROWS; r += 1) {
+        if (!live.full && !strcmp(rows[r], shown[r]))
+            continue;
+        o += sprintf(o, ESC "[%d;1H%s" ESC "[K", r + 1, rows[r]);
+    }
+    if (o != out) {
+        fwrite(out, 1, o - out, stdout);
+        fflush(stdout);
+    }
+
+    live.front ^= 1;
+    live.full = false;
+}
+
+
+void
+serial_event(void)
+{
+    cable.at[cable.cur] = sched.at[event_serial];
+    schedule(event_serial, (u64)-1);
+    if (cable.on) {
+        /* the swap waits for the peer to get here */
+        cable.master = true;
+        cable.stop = true;
+        return;
+    }
+    /* no cable, nothing drives the line */
+    serial_finish(movie_serial_in(0xff));
+}
+
+
+void
+serial_finish(u8 in)
+{
+    memory[io_sb] = in;
+    memory[io_sc] &= 0x7f;
+    memory[io_if] |= int_mask_serial;
+}
+
+
+void
+link_open(const char *path)
+{
+    /* the first machine is booted, the second starts from power on */
+    cable.cur = 0;
+    link_switch(1);
+
+    state_load(&cable.boot);
+    rom = NULL;
+    load_rom(path);
+    link_switch(0);
+    cable.on = true;
+}
+
+
+void
+swap_bytes(void *a, void *b, size_t n)
+{
+    u8 *x = a;
+    u8 *y = b;
+    u8 t[256];
+
+    while (n) {
+        size_t k = n < sizeof t ? n : sizeof t;
+        memcpy(t, x, k);
+        memcpy(x, y, k);
+        memcpy(y, t, k);
+        x += k;
+        y += k;
+        n -= k;
+    }
+}
+
+
+void
+link_switch(int to)
+{
+    /* caches and dirty bits go along with their machine */
+    Machine *m = &cable.other;
+
+#define swap(g, o) swap_bytes(&(g), &(o), sizeof(g))
+    if (to == cable.cur)
+        return;
+    swap(cpu, m->cpu);
+    swap(reg, m->reg);
+    swap(sched, m->sched);
+    swap(idle, m->idle);
+    swap(map, m->map);
+    swap(cart, m->cart);
+    swap(timer, m->timer);
+    swap(joy, m->joy);
+    swap(ppu, m->ppu);
+    swap(tiles, m->tiles);
+    swap(apu.ch, m->ch);
+    swap(apu.sweep_period, m->sweep_period);
+    swap(apu.sweep_timer, m->sweep_timer);
+    swap(apu.sweep_shadow, m->sweep_shadow);
+    swap(apu.sweep_on, m->sweep_on);
+    swap(apu.time, m->apu_time);
+    swap(apu.next_seq, m->apu_next_seq);
+    swap(apu.seq_step, m->apu_seq_step);
+    swap(rom, m->rom);
+    swap(rom_size, m->rom_size);
+    swap_bytes(memory + 0x8000, m->memory, sizeof m->memory);
+#undef swap
+    cable.cur = to;
+}
+
+
+u64
+link_cycles(int k)
+{
+    return k == cable.cur ? cpu.cycles : cable.other.cpu.cycles;
+}
+
+
+u8 *
+link_io(int k)
+{
+    /* a machine's io page, whichever side it is on */
+    return k == cable.cur ? memory + 0xff00 : cable.other.memory + 0x7f00;
 }
 
 
 int
-str_eq(const char *s1, const char *s2)
+link_listening(int k, u64 t)
 {
-    return !strcmp(s1, s2);
+    /* only the last write is kept, the peer is never behind the one before */
+    u8 sc = t < cable.sc_at[k] ? cable.sc_before[k] : link_io(k)[io_sc & 0xff];
+
+    return (sc & 0x81) == 0x80;
+}
+
+
+u64
+link_bound(int k)
+{
+    /* a listening machine can take a byte a transfer's length after its peer */
+    int j = k ^ 1;
+
+    if (cable.done[j] || !link_listening(k, link_cycles(k)))
+        return (u64)-1;
+    if (cable.waiting[j])
+        return cable.at[j];
+    return link_cycles(j) + SERIAL_CYCLES;
+}
+
+
+int
+link_runnable(int k)
+{
+    int j = k ^ 1;
+
+    if (cable.done[k] || cable.waiting[k])
+        return false;
+    if (cable.done[j])
+        return true;
+    /* it wrote SC ahead of its peer, wait so one write is all we remember */
+    if (link_cycles(j) < cable.sc_at[k])
+        return false;
+    return link_cycles(k) < link_bound(k);
+}
+
+
+void
+link_exchange(int master)
+{
+    /* the slave is past the master's cycle, or done, neither is switched in */
+    u8 *m = link_io(master);
+    u8 *s = link_io(master ^ 1);
+    u8 in = 0xff;
+
+    if (link_listening(master ^ 1, cable.at[master])) {
+        in = s[io_sb & 0xff];
+        s[io_sb & 0xff] = m[io_sb & 0xff];
+        s[io_sc & 0xff] &= 0x7f;
+        s[io_if & 0xff] |= int_mask_serial;
+    }
+    m[io_sb & 0xff] = in;
+    m[io_sc & 0xff] &= 0x7f;
+    m[io_if & 0xff] |= int_mask_serial;
+    cable.waiting[master] = false;
+}
+
+
+void
+link_run(u64 frames)
+{
+    for (;;) {
+        int i = 0;
+        int settled = false;
+
+        if (cable.done[0] && cable.done[1])
+            break;
+
+        for (int k = 0; k < 2; k += 1) {
+            int j = k ^ 1;
+
+            if (cable.waiting[k] && (cable.done[j] || link_cycles(j) >= cable.at[k])) {
+                link_exchange(k);
+                settled = true;
+            }
+        }
+        if (settled)
+            continue;
+
+        /* stay on the switched in machine while it can run, switches are not free */
+        if (link_runnable(cable.cur))
+            i = cable.cur;
+        else if (link_runnable(cable.cur ^ 1))
+            i = cable.cur ^ 1;
+        else
+            die("link: both machines are stuck");
+
+        link_switch(i);
+        schedule(event_link, link_bound(i));
+        cable.stop = false;
+        cable.master = false;
+        while (!cable.stop && ppu.frames < frames)
+            step(false);
+        schedule(event_link, (u64)-1);
+
+        if (ppu.frames >= frames)
+            cable.done[i] = true;
+        if (cable.master)
+            cable.waiting[i] = true;
+    }
+
+    for (int k = 0; k < 2; k += 1) {
+        link_switch(k);
+        printf("frame %llu %016llx\n", ppu.frames, frame_hash(&ppu.frame[0][0]));
+    }
+}
+
+
+void
+heat_open(void)
+{
+    heat.rom_pages = rom ? rom_size >> 8 : 0;
+    heat.num_pages = heat.rom_pages + 0x100 + 1;
+    for (int k = 0; k < heat_end; k += 1)
+        if (!(heat.count[k] = calloc(heat.num_pages, sizeof(u64))))
+            die("calloc heat counters failed");
+
+    /* every page takes the slow path, which counts */
+    for (int i = 0; i < 0x100; i += 1)
+        map.attr[i] |= page_read_count | page_write_count;
+    global.step_extras |= step_heat;
+    /* skipped loop iterations would go uncounted */
+    global.no_fast_forward = true;
+    heat.on = true;
+}
+
+
+int
+heat_page(u16 addr)
+{
+    if (addr < 0x4000 && heat.rom_pages)
+        return addr >> 8;
+    if (addr < 0x8000 && heat.rom_pages)
+        return (cart.rom_bank * 0x4000 + (addr & 0x3fff)) >> 8;
+    if (addr >= 0xff80 && addr != 0xffff)
+        return heat.num_pages - 1;
+    return heat.rom_pages + (addr >> 8);
+}
+
+
+const char *
+heat_region(int page, char *name)
+{
+    int p = page - heat.rom_pages;
+
+    if (page < heat.rom_pages) {
+        sprintf(name, "rom%d", page >> 6);
+        return name;
+    }
+    if (page == heat.num_pages - 1)
+        return "hram";
+    if (p < 0x80)
+        return "rom";
+    if (p < 0xa0)
+        return "vram";
+    if (p < 0xc0)
+        return "cart ram";
+    if (p < 0xe0)
+        return "wram";
+    if (p < 0xfe)
+        return "echo";
+    if (p < 0xff)
+        return "oam";
+    return "io";
+}
+
+
+void
+heat_table(FILE *f)
+{
+    /* regions in address order, then every page that was touched */
+    char name[16];
+    char last[16] = "";
+    u64 sum[heat_end] = {0};
+
+    fprintf(f, "%-10s %12s %12s %12s\n", "region", "reads", "writes", "fetches");
+    for (int i = 0; i <= heat.num_pages; i += 1) {
+        const char *r = i < heat.num_pages ? heat_region(i, name) : "";
+
+        if (strcmp(r, last)) {
+            if (sum[heat_read] || sum[heat_write] || sum[heat_fetch])
+                fprintf(f, "%-10s %12llu %12llu %12llu\n", last,
+                        sum[heat_read], sum[heat_write], sum[heat_fetch]);
+            memset(sum, 0, sizeof sum);
+            snprintf(last, sizeof last, "%s", r);
+        }
+        if (i < heat.num_pages)
+            for (int k = 0; k < heat_end; k += 1)
+                sum[k] += heat.count[k][i];
+    }
+
+    fprintf(f, "\n%-10s %-6s %12s %12s %12s\n", "region", "page", "reads", "writes", "fetches");
+    for (int i = 0; i < heat.num_pages; i += 1) {
+        u64 *c[heat_end];
+        int p = i - heat.rom_pages;
+        u16 addr = 0;
+
+        for (int k = 0; k < heat_end; k += 1)
+            c[k] = &heat.count[k][i];
+        if (!*c[heat_read] && !*c[heat_write] && !*c[heat_fetch])
+            continue;
+
+        if (i < heat.rom_pages)
+            addr = ((i >> 6) ? 0x4000 : 0) + ((i & 0x3f) << 8);
+        else if (i == heat.num_pages - 1)
+            addr = 0xff80;
+        else
+            addr = p << 8;
+        fprintf(f, "%-10s $%04x  %12llu %12llu %12llu\n", heat_region(i, name), addr,
+                *c[heat_read], *c[heat_write], *c[heat_fetch]);
+    }
+}
+
+
+void
+heat_ppm(const char *path)
+{
+    /*
+     * One 16x16 grid of 8x8 pixel pages per switchable bank, each the
+     * whole address space with that bank at $4000. Red is writes, green
+     * reads and blue fetches, log scaled against the busiest page.
+     */
+    int banks = heat.rom_pages > 0x40 ? (heat.rom_pages >> 6) - 1 : 1;
+    int w = banks * 128;
+    int h = 128;
+    double scale[heat_end];
+    u8 *px = NULL;
+    FILE *f = NULL;
+
+    for (int k = 0; k < heat_end; k += 1) {
+        u64 max = 1;
+        for (int i = 0; i < heat.num_pages; i += 1)
+            if (heat.count[k][i] > max)
+                max = heat.count[k][i];
+        scale[k] = 255 / log2(1 + (double)max);
+    }
+
+    if (!(px = calloc(w * h, 3)))
+        die("calloc heat image failed");
+
+    for (int b = 0; b < banks; b += 1) {
+        for (int page = 0; page < 0x100; page += 1) {
+            int i = heat.rom_pages + page;
+            int x0 = b * 128 + (page & 15) * 8;
+            int y0 = (page >> 4) * 8;
+            u8 rgb[3];
+
+            if (heat.rom_pages && page < 0x40)
+                i = page;
+            else if (heat.rom_pages && page < 0x80)
+                i = (b + 1) * 0x40 + page - 0x40;
+
+            for (int k = 0; k < heat_end; k += 1) {
+                u64 n = heat.count[k][i];
+                /* io and hram share the last page */
+                if (page == 0xff)
+                    n += heat.count[k][heat.num_pages - 1];
+                rgb[k == heat_write ? 0 : k == heat_read ? 1 : 2] =
+                        (u8)(log2(1 + (double)n) * scale[k]);
+            }
+            for (int y = 0; y < 8; y += 1)
+                for (int x = 0; x < 8; x += 1)
+                    memcpy(px + ((y0 + y) * w + x0 + x) * 3, rgb, 3);
+        }
+    }
+
+    if (!(f = fopen(path, "wb")))
+        die("open %s failed", path);
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    if (fwrite(px, 3, w * h, f) != (size_t)(w * h))
+        die("write %s failed", path);
+    if (fclose(f) == EOF)
+        die("close %s failed", path);
+    free(px);
+}
+
+
+void
+heat_close(void)
+{
+    FILE *f = NULL;
+
+    if (heat.table_path) {
+        if (!(f = fopen(heat.table_path, "w")))
+            die("open %s failed", heat.table_path);
+        heat_table(f);
+        if (fclose(f) == EOF)
+            die("close %s failed", heat.table_path);
+    }
+    if (heat.ppm_path)
+        heat_ppm(heat.ppm_path);
 }
 
 
 int
 str_ends_with(const char *s, const char *suffix)
 {
-    return true;
+    size_t n = strlen(s);
+    size_t m = strlen(suffix);
+    return (n >= m) && !strcmp(s + n - m, suffix);
 }
 
 
@@ -1974,16 +7534,38 @@ int
 main(int argc, char **argv)
 {
     char line_buf[512] = "";
+    const char *dump_path = NULL;
+    const char *hashes_path = NULL;
+    const char *wav_path = NULL;
+    u64 fuzz_execs = 0;
+    int serving = false;
+    i32 until_pc = -1;
+    const char *movie_path = NULL;
+    int recording = false;
+    const char *state_hashes_path = NULL;
+    u64 hash_every = 0;
+    const char *check_path = NULL;
+    int live_hz = 0;
+    const char *link_path = NULL;
+    const char *sav_path = NULL;
+    int sav_private = false;
+    const char *cheat_codes[MAX_CHEATS];
+    int num_cheat_codes = 0;
     FILE *f;
 
+    latency.tick0 = ticks();
+    latency.ns0 = mono_ns();
+
     puts("");
     init();
+    stream.trace = -1;
+    state_save(&cable.boot);
 
     global.echo_bytes = false;
 
     /*example_program();*/
 
-    if (argc != 2) {
+    if (argc < 2) {
         die("invalid arguments");
     }
 
@@ -1991,34 +7573,242 @@ main(int argc, char **argv)
     while (*argv) {
         if (str_eq("-", *argv)) {
             f = stdin;
+        } else if (str_eq("-d", *argv)) {
+            global.disassemble = true;
+        } else if (str_eq("-no-ff", *argv)) {
+            global.no_fast_forward = true;
+#if GB_HOOKS
+        } else if (str_eq("-hook-stats", *argv)) {
+            stats_install();
+#endif
+        } else if (str_eq("-fuzz", *argv)) {
+            i32 n = 0;
+            if (!argv[1] || parse_number(&n, argv[1]) || n <= 0)
+                die("-fuzz needs a number of runs");
+            fuzz_execs = n;
+            argv += 1;
+        } else if (str_eq("-lanes", *argv)) {
+            i32 n = 0;
+            if (!argv[1] || parse_number(&n, argv[1]) || n <= 0 || n > MAX_LANES)
+                die("-lanes needs a count up to %d", MAX_LANES);
+            fuzz.lanes = n;
+            argv += 1;
+        } else if (str_eq("-serve", *argv)) {
+            serving = true;
+        } else if (str_eq("-until", *argv)) {
+            if (!argv[1] || parse_number(&until_pc, argv[1]) || until_pc < 0 || until_pc > 0xffff)
+                die("-until needs an address");
+            argv += 1;
+        } else if (str_eq("-record", *argv) || str_eq("-play", *argv)) {
+            if (!argv[1])
+                die("%s needs a file name", *argv);
+            movie_path = argv[1];
+            recording = str_eq("-record", *argv);
+            argv += 1;
+        } else if (str_eq("-state-hashes", *argv)) {
+            if (!argv[1])
+                die("-state-hashes needs a file name");
+            state_hashes_path = argv[1];
+            argv += 1;
+        } else if (str_eq("-hash-every", *argv) || str_eq("-trace-interval", *argv)) {
+            i32 n = 0;
+            if (!argv[1] || parse_number(&n, argv[1]) || n < 0)
+                die("%s needs a count", *argv);
+            if (str_eq("-hash-every", *argv))
+                hash_every = n;
+            else
+                stream.trace = n;
+            argv += 1;
+        } else if (str_eq("-check", *argv)) {
+            if (!argv[1])
+                die("-check needs a trace file");
+            check_path = argv[1];
+            argv += 1;
+        } else if (str_eq("-live", *argv)) {
+            live_hz = 30;
+        } else if (str_eq("-live-hz", *argv)) {
+            i32 n = 0;
+            if (!argv[1] || parse_number(&n, argv[1]) || n < 1 || n > 60)
+                die("-live-hz needs a rate from 1 to 60");
+            live_hz = n;
+            argv += 1;
+        } else if (str_eq("-heat", *argv) || str_eq("-heat-ppm", *argv)) {
+            if (!argv[1])
+                die("%s needs a file name", *argv);
+            if (str_eq("-heat", *argv))
+                heat.table_path = argv[1];
+            else
+                heat.ppm_path = argv[1];
+            argv += 1;
+        } else if (str_eq("-link", *argv)) {
+            if (!argv[1])
+                die("-link needs the other machine's rom");
+            link_path = argv[1];
+            argv += 1;
+        } else if (str_eq("-sav", *argv) || str_eq("-sav-private", *argv)) {
+            if (!argv[1])
+                die("%s needs a file name", *argv);
+            sav_path = argv[1];
+            sav_private = str_eq("-sav-private", *argv);
+            argv += 1;
+        } else if (str_eq("-cheat", *argv)) {
+            if (!argv[1] || num_cheat_codes == MAX_CHEATS)
+                die("-cheat needs a code");
+            cheat_codes[num_cheat_codes++] = argv[1];
+            argv += 1;
+        } else if (str_eq("-stats", *argv)) {
+            atexit(latency_dump);
+        } else if (str_eq("-bisect", *argv)) {
+            if (!argv[1] || !argv[2])
+                die("-bisect needs two builds and the arguments to run them with");
+            return bisect(argv + 1);
+        } else if (str_eq("-debug", *argv)) {
+            global.start_paused = true;
+        } else if (str_eq("-frames", *argv)) {
+            i32 n = 0;
+            if (!argv[1] || parse_number(&n, argv[1]) || n <= 0)
+                die("-frames needs a count");
+            global.frames = n;
+            argv += 1;
+        } else if (str_eq("-wav", *argv)) {
+            if (!argv[1])
+                die("-wav needs a file name");
+            wav_path = argv[1];
+            argv += 1;
+        } else if (str_eq("-dump", *argv) || str_eq("-hashes", *argv)) {
+            if (!argv[1])
+                die("%s needs a file name", *argv);
+            if (str_eq("-dump", *argv))
+                dump_path = argv[1];
+            else
+                hashes_path = argv[1];
+            argv += 1;
+        } else if (str_ends_with(*argv, ".gb")) {
+            load_rom(*argv);
+            global.reading_rom = true;
         } else {
             if (!(f = fopen(*argv, "r")))
                 die("open failed");
+        }
+        argv += 1;
+    }
+
+    if (sav_path) {
+        if (!global.reading_rom)
+            die("-sav needs a rom");
+        /* jobs and fuzz runs rewind the machine, the file would get every run */
+        if (!sav_private && (serving || fuzz_execs || link_path))
+            die("use -sav-private with -serve, -fuzz or -link");
+        sav_open(sav_path, sav_private);
+    }
+
+    /* after the rom is loaded, wherever -cheat was given */
+    for (int i = 0; i < num_cheat_codes; i += 1)
+        if (cheat_add(cheat_codes[i]))
+            die("bad cheat code %s", cheat_codes[i]);
+
+    if (link_path) {
+        if (!global.reading_rom || !global.frames)
+            die("-link needs a rom and -frames");
+        if (cheats.shadow)
+            die("rom patches and -link don't mix");
+        /* link_run drives both machines itself, none of these are set up */
+        if (dump_path || hashes_path || wav_path || movie_path)
+            die("-dump, -hashes, -wav, -record and -play don't work with -link");
+        if (heat.table_path || heat.ppm_path || check_path || state_hashes_path || stream.trace >= 0)
+            die("-heat, -check, -state-hashes and -trace-interval don't work with -link");
+        if (live_hz || serving || fuzz_execs || global.start_paused || global.disassemble)
+            die("-live, -serve, -fuzz, -debug and -d don't work with -link");
+        link_open(link_path);
+        link_run(global.frames);
+        return 0;
+    }
 
-            if (str_ends_with(*argv, ".gb")) {
-                long int filesize = 0;
+    if (heat.table_path || heat.ppm_path) {
+        heat_open();
+        atexit(heat_close);
+    }
 
-                fseek(f, 0, SEEK_END);
-                filesize = ftell(f);
-                /*debug_var("d", filesize);*/
-                assert(filesize == 0x8000);
+    /* the writer thread doesn't survive into the forked children */
+    if (serving && (dump_path || hashes_path || wav_path))
+        die("-dump, -hashes and -wav don't work with -serve");
 
-                fseek(f, 0, SEEK_SET);
-                /*debug_var("zu", ftell(f));*/
-                fread(memory, 0x8000, 1, f);
-                /*debug_var("zu", ftell(f));*/
-                assert(filesize == ftell(f));
+    if (dump_path || hashes_path)
+        dump_open(dump_path, hashes_path);
 
-                if (fclose(f) == EOF)
-                    die("close rom failed");
+    if (wav_path)
+        apu_open(wav_path);
 
-                global.reading_rom = true;
-            }
+    if (movie_path) {
+        if (!global.reading_rom)
+            die("a movie needs a rom");
+        movie_open(movie_path, recording);
+        atexit(movie_close);
+        /* a movie plays to its end unless -frames says otherwise */
+        if (!recording && !global.frames)
+            global.frames = movie.frames;
+    }
+
+    if (global.disassemble) {
+        if (!global.reading_rom)
+            die("-d needs a rom");
+        disasm();
+        return 0;
+    }
+
+    if (check_path) {
+        check_open(check_path);
+        /* the first line is the state before anything runs */
+        check_step(reg.wr.pc, (u8 *)"\0\0\0");
+    }
+
+    if (state_hashes_path || stream.trace >= 0) {
+        stream_open(state_hashes_path, hash_every);
+        atexit(stream_close);
+        if (stream.trace == 0) {
+            global.step_extras |= step_trace;
+            trace_line(stdout);
         }
-        argv += 1;
     }
 
+    if (global.reading_rom && global.start_paused)
+        debug_repl();
+
+    if (global.reading_rom && serving) {
+        /* boot to -until or -frames, then take jobs */
+        serve(until_pc, global.frames);
+        return 0;
+    }
+
+    if (global.reading_rom && fuzz_execs) {
+        /* -frames is the length of each run */
+        fuzz_run(fuzz_execs, global.frames ? global.frames : 60);
+        return 0;
+    }
+
+    if (global.reading_rom && live_hz) {
+        /* full speed, the view samples it from frame_done */
+        live_open(live_hz);
+        while (!live.quit && (!global.frames || ppu.frames < global.frames))
+            step(false);
+        live_close();
+        dump_close();
+        apu_close();
+        movie_close();
+        printf("frame %llu %016llx\n", ppu.frames, frame_hash(&ppu.frame[0][0]));
+        return 0;
+    }
 
+    if (global.reading_rom && global.frames) {
+        /* headless, no per instruction output */
+        while (ppu.frames < global.frames)
+            step(false);
+        dump_close();
+        apu_close();
+        movie_close();
+        printf("frame %llu %016llx\n", ppu.frames, frame_hash(&ppu.frame[0][0]));
+        return 0;
+    }
 
     if (global.reading_rom) {
         int i = 0;
@@ -2028,8 +7818,6 @@ main(int argc, char **argv)
 
         print_header(6);
         for (;;) {
-            u8 code[3] = {0};
-
             echo = i >= echo_from;
             if (echo) {
                 printf(ESC "[" BRIGHT_BLACK_TEXT "m");
@@ -2037,11 +7825,7 @@ main(int argc, char **argv)
                 print_line_prefix();
             }
 
-            code[0] = peek8(reg.wr.pc + 0);
-            code[1] = peek8(reg.wr.pc + 1);
-            code[2] = peek8(reg.wr.pc + 2);
-
-            eval(code, echo);
+            step(echo);
 
             if (i++ == limit)
                 die("step");
@@ -2049,7 +7833,7 @@ main(int argc, char **argv)
     } else {
         print_header(1);
         for (;;) {
-            print_line_prefix();
+            timed(print, print_line_prefix());
             if(fgets(line_buf, sizeof line_buf, f) == NULL) {
                 printf("\n\nEOF\n\n");
                 return 0;
@@ -28,6 +28,596 @@ typedef struct Opcode {
     Keyword words[4];
 } Opcode;
 
+/* hot per-opcode data read by eval(), 8 bytes per entry */
+typedef struct Opcode_Info {
+    u8 handler;
+    u8 bytes;
+    u8 cycles;
+    u8 cycles_alt;  /* branch not taken */
+    u8 flags_calc;  /* flag_mask_* bits computed from the result */
+    u8 flags_fixed; /* high nibble: flags forced, low nibble: their values */
+    u8 dst;
+    u8 src;
+} Opcode_Info;
+
+#define LIST_OF_HANDLERS \
+    X(nop) \
+    X(ld) \
+    X(inc) \
+    X(dec) \
+    X(rlca) \
+    X(add) \
+    X(rrca) \
+    X(stop) \
+    X(rla) \
+    X(jr) \
+    X(rra) \
+    X(ldi) \
+    X(daa) \
+    X(cpl) \
+    X(ldd) \
+    X(scf) \
+    X(ccf) \
+    X(halt) \
+    X(adc) \
+    X(sub) \
+    X(sbc) \
+    X(and) \
+    X(xor) \
+    X(or) \
+    X(cp) \
+    X(ret) \
+    X(pop) \
+    X(jp) \
+    X(call) \
+    X(push) \
+    X(rst) \
+    X(prefix) \
+    X(illegal) \
+    X(reti) \
+    X(ldh) \
+    X(di) \
+    X(ei) \
+    X(rlc) \
+    X(rrc) \
+    X(rl) \
+    X(rr) \
+    X(sla) \
+    X(sra) \
+    X(swap) \
+    X(srl) \
+    X(bit) \
+    X(res) \
+    X(set) \
+    X(end)
+
+
+typedef enum Handler {
+#define X(name) handler_##name,
+    LIST_OF_HANDLERS
+#undef X
+} Handler;
+
+Opcode_Info opcode_info[256] = {
+    {handler_nop, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_ld, 3, 12, 12, 0x00, 0x00, keyword_bc, keyword_u16},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_bc, keyword_a},
+    {handler_inc, 1, 8, 8, 0x00, 0x00, keyword_bc, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_b, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_b, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_u8},
+    {handler_rlca, 1, 4, 4, 0x10, 0xe0, keyword_nil, keyword_nil},
+    {handler_ld, 3, 20, 20, 0x00, 0x00, keyword_deref_u16, keyword_sp},
+    {handler_add, 1, 8, 8, 0x30, 0x40, keyword_hl, keyword_bc},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_bc},
+    {handler_dec, 1, 8, 8, 0x00, 0x00, keyword_bc, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_c, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_c, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_u8},
+    {handler_rrca, 1, 4, 4, 0x10, 0xe0, keyword_nil, keyword_nil},
+    {handler_stop, 2, 4, 4, 0x00, 0x00, keyword_u8, keyword_nil},
+    {handler_ld, 3, 12, 12, 0x00, 0x00, keyword_de, keyword_u16},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_de, keyword_a},
+    {handler_inc, 1, 8, 8, 0x00, 0x00, keyword_de, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_d, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_d, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_u8},
+    {handler_rla, 1, 4, 4, 0x10, 0xe0, keyword_nil, keyword_nil},
+    {handler_jr, 2, 12, 12, 0x00, 0x00, keyword_r8, keyword_nil},
+    {handler_add, 1, 8, 8, 0x30, 0x40, keyword_hl, keyword_de},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_de},
+    {handler_dec, 1, 8, 8, 0x00, 0x00, keyword_de, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_e, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_e, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_u8},
+    {handler_rra, 1, 4, 4, 0x10, 0xe0, keyword_nil, keyword_nil},
+    {handler_jr, 2, 12, 8, 0x00, 0x00, keyword_nz, keyword_r8},
+    {handler_ld, 3, 12, 12, 0x00, 0x00, keyword_hl, keyword_u16},
+    {handler_ldi, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_a},
+    {handler_inc, 1, 8, 8, 0x00, 0x00, keyword_hl, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_h, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_h, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_u8},
+    {handler_daa, 1, 4, 4, 0x90, 0x20, keyword_nil, keyword_nil},
+    {handler_jr, 2, 12, 8, 0x00, 0x00, keyword_z, keyword_r8},
+    {handler_add, 1, 8, 8, 0x30, 0x40, keyword_hl, keyword_hl},
+    {handler_ldi, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_hl},
+    {handler_dec, 1, 8, 8, 0x00, 0x00, keyword_hl, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_l, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_l, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_u8},
+    {handler_cpl, 1, 4, 4, 0x00, 0x66, keyword_nil, keyword_nil},
+    {handler_jr, 2, 12, 8, 0x00, 0x00, keyword_nc, keyword_r8},
+    {handler_ld, 3, 12, 12, 0x00, 0x00, keyword_sp, keyword_u16},
+    {handler_ldd, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_a},
+    {handler_inc, 1, 8, 8, 0x00, 0x00, keyword_sp, keyword_nil},
+    {handler_inc, 1, 12, 12, 0xa0, 0x40, keyword_deref_hl, keyword_nil},
+    {handler_dec, 1, 12, 12, 0xa0, 0x44, keyword_deref_hl, keyword_nil},
+    {handler_ld, 2, 12, 12, 0x00, 0x00, keyword_deref_hl, keyword_u8},
+    {handler_scf, 1, 4, 4, 0x00, 0x71, keyword_nil, keyword_nil},
+    {handler_jr, 2, 12, 8, 0x00, 0x00, keyword_cy, keyword_r8},
+    {handler_add, 1, 8, 8, 0x30, 0x40, keyword_hl, keyword_sp},
+    {handler_ldd, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_hl},
+    {handler_dec, 1, 8, 8, 0x00, 0x00, keyword_sp, keyword_nil},
+    {handler_inc, 1, 4, 4, 0xa0, 0x40, keyword_a, keyword_nil},
+    {handler_dec, 1, 4, 4, 0xa0, 0x44, keyword_a, keyword_nil},
+    {handler_ld, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_u8},
+    {handler_ccf, 1, 4, 4, 0x10, 0x60, keyword_nil, keyword_nil},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_b, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_b, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_c, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_c, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_d, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_d, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_e, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_e, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_h, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_h, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_l, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_l, keyword_a},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_b},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_c},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_d},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_e},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_h},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_l},
+    {handler_halt, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_hl, keyword_a},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_b},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_c},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_d},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_e},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_h},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_l},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_hl},
+    {handler_ld, 1, 4, 4, 0x00, 0x00, keyword_a, keyword_a},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_b},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_c},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_d},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_e},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_h},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_l},
+    {handler_add, 1, 8, 8, 0xb0, 0x40, keyword_a, keyword_deref_hl},
+    {handler_add, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_a},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_b},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_c},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_d},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_e},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_h},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_l},
+    {handler_adc, 1, 8, 8, 0xb0, 0x40, keyword_a, keyword_deref_hl},
+    {handler_adc, 1, 4, 4, 0xb0, 0x40, keyword_a, keyword_a},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_b, keyword_nil},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_c, keyword_nil},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_d, keyword_nil},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_e, keyword_nil},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_h, keyword_nil},
+    {handler_sub, 1, 4, 4, 0xb0, 0x44, keyword_l, keyword_nil},
+    {handler_sub, 1, 8, 8, 0xb0, 0x44, keyword_deref_hl, keyword_nil},
+    {handler_sub, 1, 4, 4, 0x00, 0xfc, keyword_a, keyword_nil},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_b},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_c},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_d},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_e},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_h},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_l},
+    {handler_sbc, 1, 8, 8, 0xb0, 0x44, keyword_a, keyword_deref_hl},
+    {handler_sbc, 1, 4, 4, 0xb0, 0x44, keyword_a, keyword_a},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_b, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_c, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_d, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_e, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_h, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_l, keyword_nil},
+    {handler_and, 1, 8, 8, 0x80, 0x72, keyword_deref_hl, keyword_nil},
+    {handler_and, 1, 4, 4, 0x80, 0x72, keyword_a, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_b, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_c, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_d, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_e, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_h, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x80, 0x70, keyword_l, keyword_nil},
+    {handler_xor, 1, 8, 8, 0x80, 0x70, keyword_deref_hl, keyword_nil},
+    {handler_xor, 1, 4, 4, 0x00, 0xf8, keyword_a, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_b, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_c, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_d, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_e, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_h, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_l, keyword_nil},
+    {handler_or, 1, 8, 8, 0x80, 0x70, keyword_deref_hl, keyword_nil},
+    {handler_or, 1, 4, 4, 0x80, 0x70, keyword_a, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_b, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_c, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_d, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_e, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_h, keyword_nil},
+    {handler_cp, 1, 4, 4, 0xb0, 0x44, keyword_l, keyword_nil},
+    {handler_cp, 1, 8, 8, 0xb0, 0x44, keyword_deref_hl, keyword_nil},
+    {handler_cp, 1, 4, 4, 0x00, 0xfc, keyword_a, keyword_nil},
+    {handler_ret, 1, 20, 8, 0x00, 0x00, keyword_nz, keyword_nil},
+    {handler_pop, 1, 12, 12, 0x00, 0x00, keyword_bc, keyword_nil},
+    {handler_jp, 3, 16, 12, 0x00, 0x00, keyword_nz, keyword_u16},
+    {handler_jp, 3, 16, 16, 0x00, 0x00, keyword_u16, keyword_nil},
+    {handler_call, 3, 24, 12, 0x00, 0x00, keyword_nz, keyword_u16},
+    {handler_push, 1, 16, 16, 0x00, 0x00, keyword_bc, keyword_nil},
+    {handler_add, 2, 8, 8, 0xb0, 0x40, keyword_a, keyword_u8},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_00h, keyword_nil},
+    {handler_ret, 1, 20, 8, 0x00, 0x00, keyword_z, keyword_nil},
+    {handler_ret, 1, 16, 16, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_jp, 3, 16, 12, 0x00, 0x00, keyword_z, keyword_u16},
+    {handler_prefix, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_call, 3, 24, 12, 0x00, 0x00, keyword_z, keyword_u16},
+    {handler_call, 3, 24, 24, 0x00, 0x00, keyword_u16, keyword_nil},
+    {handler_adc, 2, 8, 8, 0xb0, 0x40, keyword_a, keyword_u8},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_08h, keyword_nil},
+    {handler_ret, 1, 20, 8, 0x00, 0x00, keyword_nc, keyword_nil},
+    {handler_pop, 1, 12, 12, 0x00, 0x00, keyword_de, keyword_nil},
+    {handler_jp, 3, 16, 12, 0x00, 0x00, keyword_nc, keyword_u16},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_call, 3, 24, 12, 0x00, 0x00, keyword_nc, keyword_u16},
+    {handler_push, 1, 16, 16, 0x00, 0x00, keyword_de, keyword_nil},
+    {handler_sub, 2, 8, 8, 0xb0, 0x44, keyword_u8, keyword_nil},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_10h, keyword_nil},
+    {handler_ret, 1, 20, 8, 0x00, 0x00, keyword_cy, keyword_nil},
+    {handler_reti, 1, 16, 16, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_jp, 3, 16, 12, 0x00, 0x00, keyword_cy, keyword_u16},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_call, 3, 24, 12, 0x00, 0x00, keyword_cy, keyword_u16},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_sbc, 2, 8, 8, 0xb0, 0x44, keyword_a, keyword_u8},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_18h, keyword_nil},
+    {handler_ldh, 2, 12, 12, 0x00, 0x00, keyword_deref_u8, keyword_a},
+    {handler_pop, 1, 12, 12, 0x00, 0x00, keyword_hl, keyword_nil},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_deref_c, keyword_a},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_push, 1, 16, 16, 0x00, 0x00, keyword_hl, keyword_nil},
+    {handler_and, 2, 8, 8, 0x80, 0x72, keyword_u8, keyword_nil},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_20h, keyword_nil},
+    {handler_add, 2, 16, 16, 0x30, 0xc0, keyword_sp, keyword_r8},
+    {handler_jp, 1, 4, 4, 0x00, 0x00, keyword_hl, keyword_nil},
+    {handler_ld, 3, 16, 16, 0x00, 0x00, keyword_deref_u16, keyword_a},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_xor, 2, 8, 8, 0x80, 0x70, keyword_u8, keyword_nil},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_28h, keyword_nil},
+    {handler_ldh, 2, 12, 12, 0x00, 0x00, keyword_a, keyword_deref_u8},
+    {handler_pop, 1, 12, 12, 0xf0, 0x00, keyword_af, keyword_nil},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_a, keyword_deref_c},
+    {handler_di, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_push, 1, 16, 16, 0x00, 0x00, keyword_af, keyword_nil},
+    {handler_or, 2, 8, 8, 0x80, 0x70, keyword_u8, keyword_nil},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_30h, keyword_nil},
+    {handler_ldi, 2, 12, 12, 0x30, 0xc0, keyword_hl, keyword_sp},
+    {handler_ld, 1, 8, 8, 0x00, 0x00, keyword_sp, keyword_hl},
+    {handler_ld, 3, 16, 16, 0x00, 0x00, keyword_a, keyword_deref_u16},
+    {handler_ei, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_illegal, 1, 4, 4, 0x00, 0x00, keyword_nil, keyword_nil},
+    {handler_cp, 2, 8, 8, 0xb0, 0x44, keyword_u8, keyword_nil},
+    {handler_rst, 1, 16, 16, 0x00, 0x00, keyword_38h, keyword_nil}
+};
+
+/* cb kernels set their own flags, so flags_calc/fixed are left clear */
+Opcode_Info cb_opcode_info[256] = {
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_rlc, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_rlc, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_rrc, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_rrc, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_rl, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_rl, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_rr, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_rr, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_sla, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_sla, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_sra, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_sra, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_swap, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_swap, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_b, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_c, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_d, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_e, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_h, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_l, keyword_nil},
+    {handler_srl, 2, 16, 16, 0x00, 0x00, keyword_deref_hl, keyword_nil},
+    {handler_srl, 2, 8, 8, 0x00, 0x00, keyword_a, keyword_nil},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_0, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_1, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_2, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_3, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_4, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_5, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_6, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_a},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_b},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_c},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_d},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_e},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_h},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_l},
+    {handler_bit, 2, 12, 12, 0x00, 0x00, keyword_7, keyword_deref_hl},
+    {handler_bit, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_0, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_1, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_2, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_3, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_4, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_5, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_6, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_a},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_b},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_c},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_d},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_e},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_h},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_l},
+    {handler_res, 2, 16, 16, 0x00, 0x00, keyword_7, keyword_deref_hl},
+    {handler_res, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_0, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_0, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_1, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_1, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_2, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_2, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_3, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_3, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_4, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_4, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_5, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_5, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_6, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_6, keyword_a},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_b},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_c},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_d},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_e},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_h},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_l},
+    {handler_set, 2, 16, 16, 0x00, 0x00, keyword_7, keyword_deref_hl},
+    {handler_set, 2, 8, 8, 0x00, 0x00, keyword_7, keyword_a}
+};
+
+/* cold data, only used by the assembler and the printers */
 Opcode opcode_table[256] = {
     {0x00, "nop", 1, 4, {4, 0}, 0, {{"", false, 0}, {"", false, 0}}, true, {'-', '-', '-', '-'}, false, 1, {keyword_nop, keyword_nil, keyword_nil, keyword_nil}},
     {0x01, "ld", 3, 12, {12, 0}, 2, {{"bc", true, false, false, 0}, {"d16", true, false, false, 2}}, true, {'-', '-', '-', '-'}, false, 3, {keyword_ld, keyword_bc, keyword_u16, keyword_nil}},
@@ -287,3 +877,262 @@ Opcode opcode_table[256] = {
     {0xff, "rst", 1, 16, {16, 0}, 1, {{"38h", true, false, false, 0}, {"", false, 0}}, true, {'-', '-', '-', '-'}, false, 2, {keyword_rst, keyword_38h, keyword_nil, keyword_nil}}
 };
 
+Opcode cb_opcode_table[256] = {
+    {0x00, "rlc", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_b, keyword_nil, keyword_nil}},
+    {0x01, "rlc", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_c, keyword_nil, keyword_nil}},
+    {0x02, "rlc", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_d, keyword_nil, keyword_nil}},
+    {0x03, "rlc", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_e, keyword_nil, keyword_nil}},
+    {0x04, "rlc", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_h, keyword_nil, keyword_nil}},
+    {0x05, "rlc", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_l, keyword_nil, keyword_nil}},
+    {0x06, "rlc", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x07, "rlc", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rlc, keyword_a, keyword_nil, keyword_nil}},
+    {0x08, "rrc", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_b, keyword_nil, keyword_nil}},
+    {0x09, "rrc", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_c, keyword_nil, keyword_nil}},
+    {0x0a, "rrc", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_d, keyword_nil, keyword_nil}},
+    {0x0b, "rrc", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_e, keyword_nil, keyword_nil}},
+    {0x0c, "rrc", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_h, keyword_nil, keyword_nil}},
+    {0x0d, "rrc", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_l, keyword_nil, keyword_nil}},
+    {0x0e, "rrc", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x0f, "rrc", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rrc, keyword_a, keyword_nil, keyword_nil}},
+    {0x10, "rl", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_b, keyword_nil, keyword_nil}},
+    {0x11, "rl", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_c, keyword_nil, keyword_nil}},
+    {0x12, "rl", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_d, keyword_nil, keyword_nil}},
+    {0x13, "rl", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_e, keyword_nil, keyword_nil}},
+    {0x14, "rl", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_h, keyword_nil, keyword_nil}},
+    {0x15, "rl", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_l, keyword_nil, keyword_nil}},
+    {0x16, "rl", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x17, "rl", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rl, keyword_a, keyword_nil, keyword_nil}},
+    {0x18, "rr", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_b, keyword_nil, keyword_nil}},
+    {0x19, "rr", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_c, keyword_nil, keyword_nil}},
+    {0x1a, "rr", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_d, keyword_nil, keyword_nil}},
+    {0x1b, "rr", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_e, keyword_nil, keyword_nil}},
+    {0x1c, "rr", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_h, keyword_nil, keyword_nil}},
+    {0x1d, "rr", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_l, keyword_nil, keyword_nil}},
+    {0x1e, "rr", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x1f, "rr", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_rr, keyword_a, keyword_nil, keyword_nil}},
+    {0x20, "sla", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_b, keyword_nil, keyword_nil}},
+    {0x21, "sla", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_c, keyword_nil, keyword_nil}},
+    {0x22, "sla", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_d, keyword_nil, keyword_nil}},
+    {0x23, "sla", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_e, keyword_nil, keyword_nil}},
+    {0x24, "sla", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_h, keyword_nil, keyword_nil}},
+    {0x25, "sla", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_l, keyword_nil, keyword_nil}},
+    {0x26, "sla", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x27, "sla", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sla, keyword_a, keyword_nil, keyword_nil}},
+    {0x28, "sra", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_b, keyword_nil, keyword_nil}},
+    {0x29, "sra", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_c, keyword_nil, keyword_nil}},
+    {0x2a, "sra", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_d, keyword_nil, keyword_nil}},
+    {0x2b, "sra", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_e, keyword_nil, keyword_nil}},
+    {0x2c, "sra", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_h, keyword_nil, keyword_nil}},
+    {0x2d, "sra", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_l, keyword_nil, keyword_nil}},
+    {0x2e, "sra", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x2f, "sra", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_sra, keyword_a, keyword_nil, keyword_nil}},
+    {0x30, "swap", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_b, keyword_nil, keyword_nil}},
+    {0x31, "swap", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_c, keyword_nil, keyword_nil}},
+    {0x32, "swap", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_d, keyword_nil, keyword_nil}},
+    {0x33, "swap", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_e, keyword_nil, keyword_nil}},
+    {0x34, "swap", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_h, keyword_nil, keyword_nil}},
+    {0x35, "swap", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_l, keyword_nil, keyword_nil}},
+    {0x36, "swap", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x37, "swap", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', '0'}, true, 2, {keyword_swap, keyword_a, keyword_nil, keyword_nil}},
+    {0x38, "srl", 2, 8, {8, 0}, 1, {{"b", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_b, keyword_nil, keyword_nil}},
+    {0x39, "srl", 2, 8, {8, 0}, 1, {{"c", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_c, keyword_nil, keyword_nil}},
+    {0x3a, "srl", 2, 8, {8, 0}, 1, {{"d", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_d, keyword_nil, keyword_nil}},
+    {0x3b, "srl", 2, 8, {8, 0}, 1, {{"e", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_e, keyword_nil, keyword_nil}},
+    {0x3c, "srl", 2, 8, {8, 0}, 1, {{"h", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_h, keyword_nil, keyword_nil}},
+    {0x3d, "srl", 2, 8, {8, 0}, 1, {{"l", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_l, keyword_nil, keyword_nil}},
+    {0x3e, "srl", 2, 16, {16, 0}, 1, {{"hl", false, false, false, 0}, {"", false, 0}}, false, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_deref_hl, keyword_nil, keyword_nil}},
+    {0x3f, "srl", 2, 8, {8, 0}, 1, {{"a", true, false, false, 0}, {"", false, 0}}, true, {'z', '0', '0', 'c'}, true, 2, {keyword_srl, keyword_a, keyword_nil, keyword_nil}},
+    {0x40, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_b, keyword_nil}},
+    {0x41, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_c, keyword_nil}},
+    {0x42, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_d, keyword_nil}},
+    {0x43, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_e, keyword_nil}},
+    {0x44, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_h, keyword_nil}},
+    {0x45, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_l, keyword_nil}},
+    {0x46, "bit", 2, 12, {12, 0}, 2, {{"0", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_deref_hl, keyword_nil}},
+    {0x47, "bit", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_0, keyword_a, keyword_nil}},
+    {0x48, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_b, keyword_nil}},
+    {0x49, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_c, keyword_nil}},
+    {0x4a, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_d, keyword_nil}},
+    {0x4b, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_e, keyword_nil}},
+    {0x4c, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_h, keyword_nil}},
+    {0x4d, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_l, keyword_nil}},
+    {0x4e, "bit", 2, 12, {12, 0}, 2, {{"1", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_deref_hl, keyword_nil}},
+    {0x4f, "bit", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_1, keyword_a, keyword_nil}},
+    {0x50, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_b, keyword_nil}},
+    {0x51, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_c, keyword_nil}},
+    {0x52, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_d, keyword_nil}},
+    {0x53, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_e, keyword_nil}},
+    {0x54, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_h, keyword_nil}},
+    {0x55, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_l, keyword_nil}},
+    {0x56, "bit", 2, 12, {12, 0}, 2, {{"2", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_deref_hl, keyword_nil}},
+    {0x57, "bit", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_2, keyword_a, keyword_nil}},
+    {0x58, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_b, keyword_nil}},
+    {0x59, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_c, keyword_nil}},
+    {0x5a, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_d, keyword_nil}},
+    {0x5b, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_e, keyword_nil}},
+    {0x5c, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_h, keyword_nil}},
+    {0x5d, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_l, keyword_nil}},
+    {0x5e, "bit", 2, 12, {12, 0}, 2, {{"3", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_deref_hl, keyword_nil}},
+    {0x5f, "bit", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_3, keyword_a, keyword_nil}},
+    {0x60, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_b, keyword_nil}},
+    {0x61, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_c, keyword_nil}},
+    {0x62, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_d, keyword_nil}},
+    {0x63, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_e, keyword_nil}},
+    {0x64, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_h, keyword_nil}},
+    {0x65, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_l, keyword_nil}},
+    {0x66, "bit", 2, 12, {12, 0}, 2, {{"4", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_deref_hl, keyword_nil}},
+    {0x67, "bit", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_4, keyword_a, keyword_nil}},
+    {0x68, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_b, keyword_nil}},
+    {0x69, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_c, keyword_nil}},
+    {0x6a, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_d, keyword_nil}},
+    {0x6b, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_e, keyword_nil}},
+    {0x6c, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_h, keyword_nil}},
+    {0x6d, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_l, keyword_nil}},
+    {0x6e, "bit", 2, 12, {12, 0}, 2, {{"5", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_deref_hl, keyword_nil}},
+    {0x6f, "bit", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_5, keyword_a, keyword_nil}},
+    {0x70, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_b, keyword_nil}},
+    {0x71, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_c, keyword_nil}},
+    {0x72, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_d, keyword_nil}},
+    {0x73, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_e, keyword_nil}},
+    {0x74, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_h, keyword_nil}},
+    {0x75, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_l, keyword_nil}},
+    {0x76, "bit", 2, 12, {12, 0}, 2, {{"6", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_deref_hl, keyword_nil}},
+    {0x77, "bit", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_6, keyword_a, keyword_nil}},
+    {0x78, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_b, keyword_nil}},
+    {0x79, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_c, keyword_nil}},
+    {0x7a, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_d, keyword_nil}},
+    {0x7b, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_e, keyword_nil}},
+    {0x7c, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_h, keyword_nil}},
+    {0x7d, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_l, keyword_nil}},
+    {0x7e, "bit", 2, 12, {12, 0}, 2, {{"7", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_deref_hl, keyword_nil}},
+    {0x7f, "bit", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'z', '0', '1', '-'}, true, 3, {keyword_bit, keyword_7, keyword_a, keyword_nil}},
+    {0x80, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_b, keyword_nil}},
+    {0x81, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_c, keyword_nil}},
+    {0x82, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_d, keyword_nil}},
+    {0x83, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_e, keyword_nil}},
+    {0x84, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_h, keyword_nil}},
+    {0x85, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_l, keyword_nil}},
+    {0x86, "res", 2, 16, {16, 0}, 2, {{"0", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_deref_hl, keyword_nil}},
+    {0x87, "res", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_0, keyword_a, keyword_nil}},
+    {0x88, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_b, keyword_nil}},
+    {0x89, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_c, keyword_nil}},
+    {0x8a, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_d, keyword_nil}},
+    {0x8b, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_e, keyword_nil}},
+    {0x8c, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_h, keyword_nil}},
+    {0x8d, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_l, keyword_nil}},
+    {0x8e, "res", 2, 16, {16, 0}, 2, {{"1", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_deref_hl, keyword_nil}},
+    {0x8f, "res", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_1, keyword_a, keyword_nil}},
+    {0x90, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_b, keyword_nil}},
+    {0x91, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_c, keyword_nil}},
+    {0x92, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_d, keyword_nil}},
+    {0x93, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_e, keyword_nil}},
+    {0x94, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_h, keyword_nil}},
+    {0x95, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_l, keyword_nil}},
+    {0x96, "res", 2, 16, {16, 0}, 2, {{"2", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_deref_hl, keyword_nil}},
+    {0x97, "res", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_2, keyword_a, keyword_nil}},
+    {0x98, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_b, keyword_nil}},
+    {0x99, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_c, keyword_nil}},
+    {0x9a, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_d, keyword_nil}},
+    {0x9b, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_e, keyword_nil}},
+    {0x9c, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_h, keyword_nil}},
+    {0x9d, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_l, keyword_nil}},
+    {0x9e, "res", 2, 16, {16, 0}, 2, {{"3", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_deref_hl, keyword_nil}},
+    {0x9f, "res", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_3, keyword_a, keyword_nil}},
+    {0xa0, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_b, keyword_nil}},
+    {0xa1, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_c, keyword_nil}},
+    {0xa2, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_d, keyword_nil}},
+    {0xa3, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_e, keyword_nil}},
+    {0xa4, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_h, keyword_nil}},
+    {0xa5, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_l, keyword_nil}},
+    {0xa6, "res", 2, 16, {16, 0}, 2, {{"4", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_deref_hl, keyword_nil}},
+    {0xa7, "res", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_4, keyword_a, keyword_nil}},
+    {0xa8, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_b, keyword_nil}},
+    {0xa9, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_c, keyword_nil}},
+    {0xaa, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_d, keyword_nil}},
+    {0xab, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_e, keyword_nil}},
+    {0xac, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_h, keyword_nil}},
+    {0xad, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_l, keyword_nil}},
+    {0xae, "res", 2, 16, {16, 0}, 2, {{"5", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_deref_hl, keyword_nil}},
+    {0xaf, "res", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_5, keyword_a, keyword_nil}},
+    {0xb0, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_b, keyword_nil}},
+    {0xb1, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_c, keyword_nil}},
+    {0xb2, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_d, keyword_nil}},
+    {0xb3, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_e, keyword_nil}},
+    {0xb4, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_h, keyword_nil}},
+    {0xb5, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_l, keyword_nil}},
+    {0xb6, "res", 2, 16, {16, 0}, 2, {{"6", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_deref_hl, keyword_nil}},
+    {0xb7, "res", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_6, keyword_a, keyword_nil}},
+    {0xb8, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_b, keyword_nil}},
+    {0xb9, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_c, keyword_nil}},
+    {0xba, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_d, keyword_nil}},
+    {0xbb, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_e, keyword_nil}},
+    {0xbc, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_h, keyword_nil}},
+    {0xbd, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_l, keyword_nil}},
+    {0xbe, "res", 2, 16, {16, 0}, 2, {{"7", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_deref_hl, keyword_nil}},
+    {0xbf, "res", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_res, keyword_7, keyword_a, keyword_nil}},
+    {0xc0, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_b, keyword_nil}},
+    {0xc1, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_c, keyword_nil}},
+    {0xc2, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_d, keyword_nil}},
+    {0xc3, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_e, keyword_nil}},
+    {0xc4, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_h, keyword_nil}},
+    {0xc5, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_l, keyword_nil}},
+    {0xc6, "set", 2, 16, {16, 0}, 2, {{"0", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_deref_hl, keyword_nil}},
+    {0xc7, "set", 2, 8, {8, 0}, 2, {{"0", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_0, keyword_a, keyword_nil}},
+    {0xc8, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_b, keyword_nil}},
+    {0xc9, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_c, keyword_nil}},
+    {0xca, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_d, keyword_nil}},
+    {0xcb, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_e, keyword_nil}},
+    {0xcc, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_h, keyword_nil}},
+    {0xcd, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_l, keyword_nil}},
+    {0xce, "set", 2, 16, {16, 0}, 2, {{"1", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_deref_hl, keyword_nil}},
+    {0xcf, "set", 2, 8, {8, 0}, 2, {{"1", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_1, keyword_a, keyword_nil}},
+    {0xd0, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_b, keyword_nil}},
+    {0xd1, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_c, keyword_nil}},
+    {0xd2, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_d, keyword_nil}},
+    {0xd3, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_e, keyword_nil}},
+    {0xd4, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_h, keyword_nil}},
+    {0xd5, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_l, keyword_nil}},
+    {0xd6, "set", 2, 16, {16, 0}, 2, {{"2", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_deref_hl, keyword_nil}},
+    {0xd7, "set", 2, 8, {8, 0}, 2, {{"2", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_2, keyword_a, keyword_nil}},
+    {0xd8, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_b, keyword_nil}},
+    {0xd9, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_c, keyword_nil}},
+    {0xda, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_d, keyword_nil}},
+    {0xdb, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_e, keyword_nil}},
+    {0xdc, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_h, keyword_nil}},
+    {0xdd, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_l, keyword_nil}},
+    {0xde, "set", 2, 16, {16, 0}, 2, {{"3", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_deref_hl, keyword_nil}},
+    {0xdf, "set", 2, 8, {8, 0}, 2, {{"3", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_3, keyword_a, keyword_nil}},
+    {0xe0, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_b, keyword_nil}},
+    {0xe1, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_c, keyword_nil}},
+    {0xe2, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_d, keyword_nil}},
+    {0xe3, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_e, keyword_nil}},
+    {0xe4, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_h, keyword_nil}},
+    {0xe5, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_l, keyword_nil}},
+    {0xe6, "set", 2, 16, {16, 0}, 2, {{"4", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_deref_hl, keyword_nil}},
+    {0xe7, "set", 2, 8, {8, 0}, 2, {{"4", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_4, keyword_a, keyword_nil}},
+    {0xe8, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_b, keyword_nil}},
+    {0xe9, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_c, keyword_nil}},
+    {0xea, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_d, keyword_nil}},
+    {0xeb, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_e, keyword_nil}},
+    {0xec, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_h, keyword_nil}},
+    {0xed, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_l, keyword_nil}},
+    {0xee, "set", 2, 16, {16, 0}, 2, {{"5", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_deref_hl, keyword_nil}},
+    {0xef, "set", 2, 8, {8, 0}, 2, {{"5", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_5, keyword_a, keyword_nil}},
+    {0xf0, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_b, keyword_nil}},
+    {0xf1, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_c, keyword_nil}},
+    {0xf2, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_d, keyword_nil}},
+    {0xf3, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_e, keyword_nil}},
+    {0xf4, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_h, keyword_nil}},
+    {0xf5, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_l, keyword_nil}},
+    {0xf6, "set", 2, 16, {16, 0}, 2, {{"6", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_deref_hl, keyword_nil}},
+    {0xf7, "set", 2, 8, {8, 0}, 2, {{"6", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_6, keyword_a, keyword_nil}},
+    {0xf8, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"b", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_b, keyword_nil}},
+    {0xf9, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"c", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_c, keyword_nil}},
+    {0xfa, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"d", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_d, keyword_nil}},
+    {0xfb, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"e", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_e, keyword_nil}},
+    {0xfc, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"h", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_h, keyword_nil}},
+    {0xfd, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"l", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_l, keyword_nil}},
+    {0xfe, "set", 2, 16, {16, 0}, 2, {{"7", true, false, false, 0}, {"hl", false, false, false, 0}}, false, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_deref_hl, keyword_nil}},
+    {0xff, "set", 2, 8, {8, 0}, 2, {{"7", true, false, false, 0}, {"a", true, false, false, 0}}, true, {'-', '-', '-', '-'}, true, 3, {keyword_set, keyword_7, keyword_a, keyword_nil}}
+};
+